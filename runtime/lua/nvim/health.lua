@@ -175,6 +175,61 @@ local function check_performance()
   end
 end
 
+local function format_bytes(bytes)
+  if bytes >= 1024 * 1024 then
+    return ('%.1f MiB'):format(bytes / 1024 / 1024)
+  elseif bytes >= 1024 then
+    return ('%.1f KiB'):format(bytes / 1024)
+  end
+  return ('%d B'):format(bytes)
+end
+
+local function check_memory()
+  health.start('Memory')
+
+  local stats = vim.api.nvim__memstats()
+  for _, name in ipairs({
+    'memline',
+    'undo',
+    'extmarks',
+    'syntax',
+    'scrollback',
+    'lists',
+    'dicts',
+    'lua',
+    'rpc',
+  }) do
+    health.info(
+      ('%s: %s (%d objects)'):format(name, format_bytes(stats[name].bytes), stats[name].count)
+    )
+  end
+
+  -- Show the buffers that use the most memory.
+  local buffers = stats.buffers
+  for _, b in ipairs(buffers) do
+    b.bytes = 0
+    for _, name in ipairs({ 'memline', 'undo', 'extmarks', 'syntax', 'scrollback' }) do
+      b.bytes = b.bytes + b[name].bytes
+    end
+  end
+  table.sort(buffers, function(a, b)
+    return a.bytes > b.bytes
+  end)
+  for i = 1, math.min(#buffers, 5) do
+    local b = buffers[i]
+    health.info(
+      ('buffer %d "%s": %s (memline %s, undo %s, extmarks %s)'):format(
+        b.buf,
+        vim.fn.bufname(b.buf),
+        format_bytes(b.bytes),
+        format_bytes(b.memline.bytes),
+        format_bytes(b.undo.bytes),
+        format_bytes(b.extmarks.bytes)
+      )
+    )
+  end
+end
+
 -- Load the remote plugin manifest file and check for unregistered plugins
 local function check_rplugin_manifest()
   health.start('Remote Plugins')
@@ -400,6 +455,7 @@ function M.check()
   check_config()
   check_runtime()
   check_performance()
+  check_memory()
   check_rplugin_manifest()
   check_terminal()
   check_tmux()
@@ -99,6 +99,16 @@ function vim.api.nvim__inspect_cell(grid, row, col) end
 ---
 function vim.api.nvim__invalidate_glyph_cache() end
 
+--- @private
+--- Gets the memory used by various subsystems.
+---
+--- Each subsystem is reported as a dict with "count", the number of objects,
+--- and "bytes", the memory allocated for them. "buffers" has the memline,
+--- undo, extmarks, syntax and scrollback of each buffer.
+---
+--- @return table<string,any>
+function vim.api.nvim__memstats() end
+
 --- @private
 --- EXPERIMENTAL: this API may change in the future.
 ---
@@ -139,6 +149,18 @@ function vim.api.nvim__screenshot(path) end
 --- @return table<string,any>
 function vim.api.nvim__stats() end
 
+--- @private
+--- Gets the recent spans of the event loop, redrawing, RPC requests,
+--- autocommands, garbage collection, swapfile syncing and treesitter parsing.
+---
+--- The result is JSON in the Chrome trace event format, which can be loaded
+--- in chrome://tracing or https://ui.perfetto.dev.
+---
+--- @param ms integer Only spans that ended in the last {ms} milliseconds. 0 for all
+---           the recorded spans.
+--- @return string
+function vim.api.nvim__trace(ms) end
+
 --- @private
 --- @param str string
 --- @return any
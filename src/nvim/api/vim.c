@@ -29,6 +29,7 @@
 #include "nvim/decoration.h"
 #include "nvim/drawscreen.h"
 #include "nvim/eval.h"
+#include "nvim/eval/gc.h"
 #include "nvim/eval/typval.h"
 #include "nvim/eval/typval_defs.h"
 #include "nvim/ex_docmd.h"
@@ -50,8 +51,10 @@
 #include "nvim/mapping.h"
 #include "nvim/mark.h"
 #include "nvim/mark_defs.h"
+#include "nvim/marktree.h"
 #include "nvim/math.h"
 #include "nvim/mbyte.h"
+#include "nvim/memfile.h"
 #include "nvim/memline.h"
 #include "nvim/memory.h"
 #include "nvim/memory_defs.h"
@@ -78,9 +81,12 @@
 #include "nvim/statusline.h"
 #include "nvim/statusline_defs.h"
 #include "nvim/strings.h"
+#include "nvim/syntax.h"
 #include "nvim/terminal.h"
+#include "nvim/trace.h"
 #include "nvim/types_defs.h"
 #include "nvim/ui.h"
+#include "nvim/undo.h"
 #include "nvim/vim_defs.h"
 #include "nvim/window.h"
 
@@ -1773,21 +1779,144 @@ Float nvim__id_float(Float flt)
   return flt;
 }
 
+/// Per-buffer subsystems reported by nvim__memstats().
+enum {
+  kMemBufMemline,
+  kMemBufUndo,
+  kMemBufExtmarks,
+  kMemBufSyntax,
+  kMemBufScrollback,
+  kMemBufCount,
+};
+
+static const char *const mem_buf_names[kMemBufCount] = {
+  [kMemBufMemline] = "memline",
+  [kMemBufUndo] = "undo",
+  [kMemBufExtmarks] = "extmarks",
+  [kMemBufSyntax] = "syntax",
+  [kMemBufScrollback] = "scrollback",
+};
+
 /// Gets internal stats.
 ///
 /// @return Map of various internal stats.
 Dictionary nvim__stats(Arena *arena)
 {
-  Dictionary rv = arena_dict(arena, 6);
+  Dictionary rv = arena_dict(arena, 10);
   PUT_C(rv, "fsync", INTEGER_OBJ(g_stats.fsync));
   PUT_C(rv, "log_skip", INTEGER_OBJ(g_stats.log_skip));
   PUT_C(rv, "lua_refcount", INTEGER_OBJ(nlua_get_global_ref_count()));
   PUT_C(rv, "redraw", INTEGER_OBJ(g_stats.redraw));
+  PUT_C(rv, "spawn", INTEGER_OBJ(g_stats.spawn));
+  PUT_C(rv, "spawn_direct", INTEGER_OBJ(g_stats.spawn_direct));
+  PUT_C(rv, "spawn_time", INTEGER_OBJ((Integer)g_stats.spawn_time));
   PUT_C(rv, "arena_alloc_count", INTEGER_OBJ((Integer)arena_alloc_count));
   PUT_C(rv, "ts_query_parse_count", INTEGER_OBJ((Integer)tslua_query_parse_count));
+  PUT_C(rv, "pools", ARRAY_OBJ(pool_stats_array(arena)));
+  return rv;
+}
+
+static Array pool_stats_array(Arena *arena)
+{
+  size_t obj_size, live, slabs;
+  size_t count = 0;
+  for (size_t i = 0; pool_stats(i, &obj_size, &live, &slabs); i++) {
+    count += slabs > 0;
+  }
+  Array rv = arena_array(arena, count);
+  for (size_t i = 0; pool_stats(i, &obj_size, &live, &slabs); i++) {
+    if (slabs > 0) {
+      Dictionary d = arena_dict(arena, 3);
+      PUT_C(d, "size", INTEGER_OBJ((Integer)obj_size));
+      PUT_C(d, "live", INTEGER_OBJ((Integer)live));
+      PUT_C(d, "slabs", INTEGER_OBJ((Integer)slabs));
+      ADD_C(rv, DICTIONARY_OBJ(d));
+    }
+  }
+  return rv;
+}
+
+/// Gets the memory used by various subsystems.
+///
+/// Each subsystem is reported as a dict with "count", the number of objects,
+/// and "bytes", the memory allocated for them.  "buffers" has the memline,
+/// undo, extmarks, syntax and scrollback of each buffer.
+///
+/// @return Map of memory stats.
+Dictionary nvim__memstats(Arena *arena)
+{
+  MemGauge lists = { 0 }, dicts = { 0 }, lua = { 0 }, rpc = { 0 };
+  gc_mem_usage(&lists, &dicts);
+  nlua_mem_usage(&lua);
+  rpc_mem_usage(&rpc);
+
+  size_t nbufs = 0;
+  FOR_ALL_BUFFERS(buf) {
+    nbufs++;
+  }
+  MemGauge total[kMemBufCount] = { 0 };
+  Array buffers = arena_array(arena, nbufs);
+  FOR_ALL_BUFFERS(buf) {
+    MemGauge g[kMemBufCount] = { 0 };
+    if (buf->b_ml.ml_mfp != NULL) {
+      mf_mem_usage(buf->b_ml.ml_mfp, &g[kMemBufMemline]);
+    }
+    u_mem_usage(buf, &g[kMemBufUndo]);
+    marktree_mem_usage(buf->b_marktree, &g[kMemBufExtmarks]);
+    syn_mem_usage(&buf->b_s, &g[kMemBufSyntax]);
+    if (buf->terminal != NULL) {
+      terminal_mem_usage(buf->terminal, &g[kMemBufScrollback]);
+    }
+
+    Dictionary d = arena_dict(arena, kMemBufCount + 1);
+    PUT_C(d, "buf", BUFFER_OBJ(buf->handle));
+    for (int i = 0; i < kMemBufCount; i++) {
+      PUT_C(d, mem_buf_names[i], DICTIONARY_OBJ(mem_gauge_dict(arena, g[i])));
+      total[i].count += g[i].count;
+      total[i].bytes += g[i].bytes;
+    }
+    ADD_C(buffers, DICTIONARY_OBJ(d));
+  }
+
+  Dictionary rv = arena_dict(arena, kMemBufCount + 5);
+  PUT_C(rv, "lists", DICTIONARY_OBJ(mem_gauge_dict(arena, lists)));
+  PUT_C(rv, "dicts", DICTIONARY_OBJ(mem_gauge_dict(arena, dicts)));
+  PUT_C(rv, "lua", DICTIONARY_OBJ(mem_gauge_dict(arena, lua)));
+  PUT_C(rv, "rpc", DICTIONARY_OBJ(mem_gauge_dict(arena, rpc)));
+  for (int i = 0; i < kMemBufCount; i++) {
+    PUT_C(rv, mem_buf_names[i], DICTIONARY_OBJ(mem_gauge_dict(arena, total[i])));
+  }
+  PUT_C(rv, "buffers", ARRAY_OBJ(buffers));
   return rv;
 }
 
+static Dictionary mem_gauge_dict(Arena *arena, MemGauge gauge)
+{
+  Dictionary d = arena_dict(arena, 2);
+  PUT_C(d, "count", INTEGER_OBJ((Integer)gauge.count));
+  PUT_C(d, "bytes", INTEGER_OBJ((Integer)gauge.bytes));
+  return d;
+}
+
+/// Gets the recent spans of the event loop, redrawing, RPC requests,
+/// autocommands, garbage collection, swapfile syncing and treesitter parsing.
+///
+/// The result is JSON in the Chrome trace event format, which can be loaded
+/// in chrome://tracing or https://ui.perfetto.dev.
+///
+/// @param ms  Only spans that ended in the last {ms} milliseconds. 0 for all
+///            the recorded spans.
+/// @param[out] err Error details, if any
+/// @return JSON string.
+String nvim__trace(Integer ms, Error *err)
+  FUNC_API_RET_ALLOC
+{
+  VALIDATE_RANGE(ms >= 0, "ms", {
+    return NULL_STRING;
+  });
+  return trace_dump(ms);
+}
+
 /// Gets a list of dictionaries representing attached UIs.
 ///
 /// @return Array of UI dictionaries, each with these keys:
@@ -56,6 +56,8 @@
 #include "nvim/state.h"
 #include "nvim/state_defs.h"
 #include "nvim/strings.h"
+#include "nvim/trace.h"
+#include "nvim/trace_defs.h"
 #include "nvim/types_defs.h"
 #include "nvim/ui.h"
 #include "nvim/ui_compositor.h"
@@ -1824,7 +1826,9 @@ bool apply_autocmds_group(event_T event, char *fname, char *fname_io, bool force
     const bool save_ex_pressedreturn = get_pressedreturn();
 
     // Execute the autocmd. The `getnextac` callback handles iteration.
+    uint64_t trace_start = trace_begin();
     do_cmdline(NULL, getnextac, &patcmd, DOCMD_NOWAIT | DOCMD_VERBOSE | DOCMD_REPEAT);
+    trace_end(kTraceAutocmd, trace_start, event, autocmd_bufnr);
 
     did_emsg += save_did_emsg;
     set_pressedreturn(save_ex_pressedreturn);
@@ -1718,6 +1718,7 @@ void enter_buffer(buf_T *buf)
 
   // mark cursor position as being invalid
   curwin->w_valid = 0;
+  vcol_checkpoint_clear(curwin);
 
   // Make sure the buffer is loaded.
   if (curbuf->b_ml.ml_mfp == NULL) {    // need to load the file
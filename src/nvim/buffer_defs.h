@@ -816,6 +816,39 @@ typedef struct {
   linenr_T wl_lastlnum;         // last buffer line number for logical line
 } wline_T;
 
+// Cached height of a buffer line in a window, see plines_win_nofold().
+typedef struct {
+  linenr_T pe_lnum;             // buffer line number, zero when unused
+  colnr_T pe_len;               // length of the line
+  int pe_height;                // height in screen lines
+} plines_entry_T;
+
+// Cache of line heights in a window.  Entries are only valid for the buffer,
+// text width and option generation they were computed with.
+typedef struct {
+  plines_entry_T *pc_entries;   // allocated when first used
+  handle_T pc_buf;              // handle of the buffer
+  int pc_width;                 // width of the first screen line of a line
+  int pc_width2;                // extra width of the following lines
+  unsigned pc_gen;              // value of plines_cache_gen
+} plines_cache_T;
+
+// Virtual column of a character in a long line, see vcol_checkpoint_find().
+typedef struct {
+  colnr_T vp_col;               // byte index of the character
+  colnr_T vp_vcol;              // virtual column where the character starts
+} vcol_point_T;
+
+// Checkpoints of virtual columns in one long line of a window.  Point "i" is
+// for the first character at or after byte (i + 1) * VCOL_CHECKPOINT_STEP.
+typedef struct {
+  linenr_T vc_lnum;             // buffer line number, zero when unused
+  handle_T vc_buf;              // handle of the buffer
+  varnumber_T vc_changedtick;   // b:changedtick of the buffer
+  unsigned vc_gen;              // value of plines_cache_gen
+  kvec_t(vcol_point_T) vc_points;
+} vcol_cache_T;
+
 // Windows are kept in a tree of frames.  Each frame has a column (FR_COL)
 // or row (FR_ROW) layout or is a leaf, which has a window.
 struct frame_S {
@@ -1064,6 +1097,8 @@ struct window_S {
                                     ///< can be different from w_cursor.lnum
                                     ///< for closed folds.
   linenr_T w_last_cursorline;       ///< where last 'cursorline' was drawn
+  linenr_T w_cul_drawn_lnum;        ///< cursor line last drawn by win_line(),
+                                    ///< 0 when not drawn
 
   // the next seven are used to update the visual part
   char w_old_visual_mode;           ///< last known VIsual_mode
@@ -1196,6 +1231,10 @@ struct window_S {
   int w_lines_valid;                // number of valid entries
   wline_T *w_lines;
 
+  plines_cache_T w_plines_cache;    // heights of long lines, independent of
+                                    // what is displayed
+  vcol_cache_T w_vcol_cache;        // virtual columns in a long line
+
   garray_T w_folds;                 // array of nested folds
   bool w_fold_manual;               // when true: some folds are opened/closed
                                     // manually
@@ -1216,6 +1255,7 @@ struct window_S {
   linenr_T w_redraw_bot;            // when != 0: last line needing redraw
   bool w_redr_status;               // if true statusline/winbar must be redrawn
   bool w_redr_border;               // if true border must be redrawn
+  bool w_redr_sep;                  // if true separators must be redrawn
   bool w_redr_statuscol;            // if true 'statuscolumn' must be redrawn
 
   // remember what is shown in the 'statusline'-format elements
@@ -1228,6 +1268,9 @@ struct window_S {
   int w_stl_recording;               // reg_recording when last redrawn
   int w_stl_state;                   // get_real_state() when last redrawn
   int w_stl_visual_mode;             // VIsual_mode when last redrawn
+  bool w_stl_nocursor;               // custom 'statusline' had no cursor item
+                                     // or expression when last built
+  bool w_wbr_nocursor;               // same for 'winbar'
 
   int w_alt_fnum;                   // alternate file (for # and CTRL-^)
 
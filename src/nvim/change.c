@@ -321,6 +321,9 @@ static void changed_common(buf_T *buf, linenr_T lnum, colnr_T col, linenr_T lnum
 
   FOR_ALL_TAB_WINDOWS(tp, wp) {
     if (wp->w_buffer == buf) {
+      plines_cache_invalidate(wp, lnum, lnume, xtra);
+      vcol_checkpoint_invalidate(wp, lnum, col, lnume, xtra);
+
       // Mark this window to be redrawn later.
       if (!redraw_not_allowed && wp->w_redr_type < UPD_VALID) {
         wp->w_redr_type = UPD_VALID;
@@ -667,11 +667,13 @@ static void on_channel_output(Stream *stream, Channel *chan, RBuffer *buf, bool
 
   if (chan->term) {
     if (!eof) {
-      char *p = output;
+      // Don't pass incomplete UTF-8 sequences to libvterm. #16245
+      // Composing chars can be passed separately, so utf_ptr2len_len() is enough.
+      // Only a sequence starting in the last MB_MAXCHAR bytes can be incomplete,
+      // and lead bytes always start a sequence, so the scan can start there.
       char *end = output + count;
+      char *p = end - MIN(count, MB_MAXCHAR);
       while (p < end) {
-        // Don't pass incomplete UTF-8 sequences to libvterm. #16245
-        // Composing chars can be passed separately, so utf_ptr2len_len() is enough.
         int clen = utf_ptr2len_len(p, (int)(end - p));
         if (clen > end - p) {
           count = (size_t)(p - output);
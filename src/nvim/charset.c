@@ -751,7 +751,18 @@ int vim_strnsize(const char *s, int len)
 {
   assert(s != NULL);
   int size = 0;
+  const char *const end = s + strnlen(s, (size_t)MAX(len, 0));
   while (*s != NUL && --len >= 0) {
+    // A run of printable ASCII takes one cell per byte.
+    if (s < end) {
+      int n = (int)ascii_printable_len(s, (size_t)(end - s));
+      if (n > 0) {
+        size += n;
+        s += n;
+        len -= n - 1;
+        continue;
+      }
+    }
     int l = utfc_ptr2len(s);
     size += ptr2cells(s);
     s += l;
@@ -178,6 +178,21 @@ void decor_providers_invoke_line(win_T *wp, int row, bool *has_decor)
   decor_state.running_decor_provider = false;
 }
 
+/// @return  true if a provider is active for the window being redrawn.  Its
+///          'win' or 'line' callback may add ephemeral decorations that change
+///          every time lines are drawn.
+bool decor_providers_win_active(void)
+{
+  for (size_t i = 0; i < kv_size(decor_providers); i++) {
+    DecorProvider *p = &kv_A(decor_providers, i);
+    if (p->state == kDecorProviderActive
+        && (p->redraw_win != LUA_NOREF || p->redraw_line != LUA_NOREF)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /// For each provider invoke the 'buf' callback for a given buffer.
 ///
 /// @param      buf       Buffer
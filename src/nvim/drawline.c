@@ -1340,6 +1340,16 @@ int win_line(win_T *wp, linenr_T lnum, int startrow, int endrow, int col_rows, s
     csarg.max_head_vcol = start_col;
     int vcol = wlv.vcol;
     StrCharInfo ci = utf_ptr2StrCharInfo(ptr);
+    // In a long line skip to the last virtual column checkpoint before
+    // "start_col" that getvcol() recorded, if any.  Not with 'list', the
+    // position in 'listchars' "multispace" depends on all the text.
+    colnr_T cp_col;
+    colnr_T cp_vcol;
+    if (cstype == kCharsizeFast && !wp->w_p_list && ptr == line && vcol == 0
+        && vcol_checkpoint_find(wp, lnum, MAXCOL, start_col, &cp_col, &cp_vcol)) {
+      ci = utf_ptr2StrCharInfo(line + cp_col);
+      vcol = cp_vcol;
+    }
     while (vcol < start_col && *ci.ptr != NUL) {
       cs = win_charsize(cstype, vcol, ci.ptr, ci.chr.value, &csarg);
       vcol += cs.width;
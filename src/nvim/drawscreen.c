@@ -112,6 +112,8 @@
 #include "nvim/strings.h"
 #include "nvim/syntax.h"
 #include "nvim/terminal.h"
+#include "nvim/trace.h"
+#include "nvim/trace_defs.h"
 #include "nvim/types_defs.h"
 #include "nvim/ui.h"
 #include "nvim/ui_compositor.h"
@@ -449,7 +451,15 @@ int update_screen(void)
     return FAIL;
   }
 
+  // Highlight attribute table getting large, rebuild it with only the
+  // attributes that are still drawn.  Must use CLEAR, the attributes in the
+  // screen buffers may now mean something else.
+  if (hl_attr_compact_if_large()) {
+    must_redraw = UPD_CLEAR;
+  }
+
   int type = must_redraw;
+  uint64_t trace_start = trace_begin();
 
   // must_redraw is reset here, so that when we run into some weird
   // reason to redraw while busy redrawing (e.g., asynchronous
@@ -639,12 +649,24 @@ int update_screen(void)
       win_redr_border(wp);
     }
 
+    // The window has only moved and its grid is still valid: win_update()
+    // won't draw the separators at the new position.
+    if (wp->w_redr_sep && wp->w_redr_type < UPD_REDRAW_TOP) {
+      draw_vsep_win(wp);
+      draw_hsep_win(wp);
+      draw_sep_connectors_win(wp);
+    }
+    wp->w_redr_sep = false;
+
     if (wp->w_redr_type != 0) {
       if (!did_one) {
         did_one = true;
         start_search_hl();
       }
+      uint64_t win_trace_start = trace_begin();
+      int redr_type = wp->w_redr_type;
       win_update(wp);
+      trace_end(kTraceWinUpdate, win_trace_start, wp->handle, redr_type);
     }
 
     // redraw status line and window bar after the window to minimize cursor movement
@@ -688,6 +710,7 @@ int update_screen(void)
 
   // either cmdline is cleared, not drawn or mode is last drawn
   cmdline_was_last_drawn = false;
+  trace_end(kTraceUpdateScreen, trace_start, type, 0);
   return OK;
 }
 
@@ -870,13 +893,17 @@ void show_cursor_info_later(bool force)
       || reg_recording != curwin->w_stl_recording
       || state != curwin->w_stl_state
       || (VIsual_active && VIsual_mode != curwin->w_stl_visual_mode)) {
+    // A custom status line or window bar only needs to be redrawn when it
+    // showed something that may have changed when it was last built.
     if (curwin->w_status_height || global_stl_height()) {
-      curwin->w_redr_status = true;
+      if ((*curwin->w_p_stl == NUL && *p_stl == NUL) || !curwin->w_stl_nocursor) {
+        curwin->w_redr_status = true;
+      }
     } else {
       redraw_cmdline = true;
     }
 
-    if (*p_wbr != NUL || *curwin->w_p_wbr != NUL) {
+    if ((*p_wbr != NUL || *curwin->w_p_wbr != NUL) && !curwin->w_wbr_nocursor) {
       curwin->w_redr_status = true;
     }
 
@@ -2040,6 +2067,18 @@ static void win_update(win_T *wp)
     }
   }
 
+  // The cursor line is drawn again when the cursor moves, unless it stayed on
+  // the same line and nothing in the line depends on the cursor column.  Other
+  // changes to the line invalidate it like any other line.
+  const bool cul_unchanged = wp->w_cursorline != 0
+                             && wp->w_cursorline == wp->w_last_cursorline
+                             && wp->w_cursorline == wp->w_cul_drawn_lnum
+                             && !(wp->w_p_culopt_flags & CULOPT_SCRLINE)
+                             && wp->w_p_cole == 0
+                             && *wp->w_p_stc == NUL
+                             && !(VIsual_active && wp->w_buffer == curbuf)
+                             && !decor_providers_win_active();
+
   win_check_ns_hl(wp);
 
   spellvars_T spv = { 0 };
@@ -2101,8 +2140,8 @@ static void win_update(win_T *wp)
                         // if lines were inserted or deleted
                         || (wp->w_match_head != NULL
                             && buf->b_mod_xlines != 0)))))
-        || lnum == wp->w_cursorline
-        || lnum == wp->w_last_cursorline) {
+        || ((lnum == wp->w_cursorline || lnum == wp->w_last_cursorline)
+            && !cul_unchanged)) {
       if (lnum == mod_top) {
         top_to_mod = false;
       }
@@ -2285,6 +2324,9 @@ static void win_update(win_T *wp)
         spellvars_T zero_spv = { 0 };
         row = win_line(wp, lnum, srow, wp->w_grid.rows, 0,
                        display_buf_line ? &spv : &zero_spv, foldinfo);
+        if (lnum == wp->w_cursorline) {
+          wp->w_cul_drawn_lnum = lnum;
+        }
 
         if (display_buf_line) {
           syntax_last_parsed = lnum;
@@ -2366,6 +2408,9 @@ redr_statuscol:
   // Now that the window has been redrawn with the old and new cursor line,
   // update w_last_cursorline.
   wp->w_last_cursorline = wp->w_cursorline;
+  if (wp->w_cursorline == 0) {
+    wp->w_cul_drawn_lnum = 0;
+  }
 
   wp->w_last_cursor_lnum_rnu = wp->w_p_rnu ? wp->w_cursor.lnum : 0;
 
@@ -85,6 +85,8 @@
 #include "nvim/search.h"
 #include "nvim/strings.h"
 #include "nvim/tag.h"
+#include "nvim/trace.h"
+#include "nvim/trace_defs.h"
 #include "nvim/types_defs.h"
 #include "nvim/ui.h"
 #include "nvim/ui_compositor.h"
@@ -4425,6 +4427,7 @@ int get_copyID(void)
 /// @return  true if some memory was freed.
 bool garbage_collect(bool testing)
 {
+  uint64_t trace_start = trace_begin();
   bool abort = false;
 #define ABORTING(func) abort = abort || func
 
@@ -4628,6 +4631,7 @@ bool garbage_collect(bool testing)
     verb_msg(_("Not enough memory to set references, garbage collection aborted!"));
   }
 #undef ABORTING
+  trace_end(kTraceGarbageCollect, trace_start, testing, did_free);
   return did_free;
 }
 
@@ -5984,7 +5988,18 @@ void get_system_output_as_rettv(typval_T *argvars, typval_T *rettv, bool retlist
 
   // get shell command to execute
   bool executable = true;
-  char **argv = tv_to_argv(&argvars[0], NULL, &executable);
+  char **argv = NULL;
+  const char *direct_cmd = NULL;
+  if (argvars[0].v_type == VAR_STRING) {
+    // A simple command does not need to start 'shell'.
+    argv = shell_build_argv_direct(tv_get_string(&argvars[0]));
+    if (argv != NULL) {
+      direct_cmd = tv_get_string(&argvars[0]);
+    }
+  }
+  if (!argv) {
+    argv = tv_to_argv(&argvars[0], NULL, &executable);
+  }
   if (!argv) {
     if (!executable) {
       set_vim_var_nr(VV_SHELL_ERROR, -1);
@@ -6009,7 +6024,7 @@ void get_system_output_as_rettv(typval_T *argvars, typval_T *rettv, bool retlist
   // execute the command
   size_t nread = 0;
   char *res = NULL;
-  int status = os_system(argv, input, (size_t)input_len, &res, &nread);
+  int status = os_system(argv, input, (size_t)input_len, &res, &nread, direct_cmd);
 
   if (profiling) {
     prof_child_exit(&wait_time);
@@ -1,6 +1,9 @@
 #include <stddef.h>
 
 #include "nvim/eval/gc.h"
+#include "nvim/eval/typval_defs.h"
+#include "nvim/hashtab_defs.h"
+#include "nvim/memory_defs.h"
 
 #ifdef INCLUDE_GENERATED_DECLARATIONS
 # include "eval/gc.c.generated.h"  // IWYU pragma: export
@@ -10,3 +13,22 @@
 dict_T *gc_first_dict = NULL;
 /// Head of list of all lists
 list_T *gc_first_list = NULL;
+
+/// Add all lists and dictionaries to "lists" and "dicts".
+///
+/// Only the containers are counted, not the strings and other values inside
+/// them.  The keys of dictionary items are not counted either.
+void gc_mem_usage(MemGauge *lists, MemGauge *dicts)
+{
+  for (list_T *l = gc_first_list; l != NULL; l = l->lv_used_next) {
+    lists->count++;
+    lists->bytes += sizeof(list_T) + (size_t)l->lv_len * sizeof(listitem_T);
+  }
+  for (dict_T *d = gc_first_dict; d != NULL; d = d->dv_used_next) {
+    dicts->count++;
+    dicts->bytes += sizeof(dict_T) + d->dv_hashtab.ht_used * sizeof(dictitem_T);
+    if (d->dv_hashtab.ht_array != d->dv_hashtab.ht_smallarray) {
+      dicts->bytes += (d->dv_hashtab.ht_mask + 1) * sizeof(hashitem_T);
+    }
+  }
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "nvim/eval/typval_defs.h"
+#include "nvim/memory_defs.h"  // IWYU pragma: keep
 
 extern dict_T *gc_first_dict;
 extern list_T *gc_first_list;
@@ -117,7 +117,7 @@ const char *const tv_empty_string = "";
 static listitem_T *tv_list_item_alloc(void)
   FUNC_ATTR_NONNULL_RET FUNC_ATTR_MALLOC
 {
-  return xmalloc(sizeof(listitem_T));
+  return pool_alloc(sizeof(listitem_T));
 }
 
 /// Remove a list item from a List and free it
@@ -135,7 +135,7 @@ listitem_T *tv_list_item_remove(list_T *const l, listitem_T *const item)
   listitem_T *const next_item = TV_LIST_ITEM_NEXT(l, item);
   tv_list_drop_items(l, item, item);
   tv_clear(TV_LIST_ITEM_TV(item));
-  xfree(item);
+  pool_free(item, sizeof(listitem_T));
   return next_item;
 }
 
@@ -265,7 +265,7 @@ void tv_list_free_contents(list_T *const l)
     // Remove the item before deleting it.
     l->lv_first = item->li_next;
     tv_clear(&item->li_tv);
-    xfree(item);
+    pool_free(item, sizeof(listitem_T));
   }
   l->lv_len = 0;
   l->lv_idx_item = NULL;
@@ -363,7 +363,7 @@ void tv_list_remove_items(list_T *const l, listitem_T *const item, listitem_T *c
   for (listitem_T *li = item;;) {
     tv_clear(TV_LIST_ITEM_TV(li));
     listitem_T *const nli = li->li_next;
-    xfree(li);
+    pool_free(li, sizeof(listitem_T));
     if (li == item2) {
       break;
     }
@@ -602,7 +602,7 @@ list_T *tv_list_copy(const vimconv_T *const conv, list_T *const orig, const bool
     if (deep) {
       if (var_item_copy(conv, TV_LIST_ITEM_TV(item), TV_LIST_ITEM_TV(ni),
                         deep, copyID) == FAIL) {
-        xfree(ni);
+        pool_free(ni, sizeof(listitem_T));
         goto tv_list_copy_error;
       }
     } else {
@@ -773,7 +773,7 @@ void tv_list_flatten(list_T *list, listitem_T *first, int64_t maxitems, int64_t
                         itemlist->lv_len, maxdepth - 1);
       }
       tv_clear(&item->li_tv);
-      xfree(item);
+      pool_free(item, sizeof(listitem_T));
     }
 
     done++;
@@ -1059,7 +1059,7 @@ void tv_list_remove(typval_T *argvars, typval_T *rettv, const char *arg_errmsg)
       // Remove one item, return its value.
       tv_list_drop_items(l, item, item);
       *rettv = *TV_LIST_ITEM_TV(item);
-      xfree(item);
+      pool_free(item, sizeof(listitem_T));
     } else {
       listitem_T *item2;
       // Remove range of items, return list with values.
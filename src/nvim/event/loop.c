@@ -8,6 +8,8 @@
 #include "nvim/log.h"
 #include "nvim/memory.h"
 #include "nvim/os/time.h"
+#include "nvim/trace.h"
+#include "nvim/trace_defs.h"
 #include "nvim/types_defs.h"
 
 #ifdef INCLUDE_GENERATED_DECLARATIONS
@@ -79,8 +81,15 @@ static bool loop_uv_run(Loop *loop, int64_t ms)
 /// @return  true if `ms` > 0 and was reached
 bool loop_poll_events(Loop *loop, int64_t ms)
 {
+  uint64_t trace_start = trace_begin();
   bool timeout_expired = loop_uv_run(loop, ms);
+  // Breakchecks poll with a zero timeout very often: only record such a poll
+  // when it has events to process, so that it does not flood the trace ring.
+  bool idle = ms == 0 && multiqueue_empty(loop->fast_events);
   multiqueue_process_events(loop->fast_events);
+  if (!idle) {
+    trace_end(kTracePollEvents, trace_start, ms, timeout_expired);
+  }
   return timeout_expired;
 }
 
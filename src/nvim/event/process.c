@@ -67,6 +67,7 @@ int process_spawn(Process *proc, bool in, bool out, bool err)
   __gcov_flush();
 #endif
 
+  uint64_t spawn_start = os_hrtime();
   int status;
   switch (proc->type) {
   case kProcessTypeUv:
@@ -76,6 +77,8 @@ int process_spawn(Process *proc, bool in, bool out, bool err)
     status = pty_process_spawn((PtyProcess *)proc);
     break;
   }
+  g_stats.spawn++;
+  g_stats.spawn_time += os_hrtime() - spawn_start;
 
   if (status) {
     if (in) {
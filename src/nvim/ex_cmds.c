@@ -348,10 +348,14 @@ static int linelen(int *has_tab)
   return len;
 }
 
-// Buffer for two lines used during sorting.  They are allocated to
-// contain the longest line being sorted.
+// Buffer for a line used during sorting.  It is allocated to contain the
+// longest line being sorted.
 static char *sortbuf1;
-static char *sortbuf2;
+
+// The keys of all lines being sorted on strings, each terminated by a NUL.
+// Comparing keys stored here avoids getting and copying both lines for every
+// comparison.
+static StringBuilder sortkeys;
 
 static bool sort_lc;      ///< sort using locale
 static bool sort_ic;      ///< ignore case
@@ -366,8 +370,9 @@ typedef struct {
   linenr_T lnum;          ///< line number
   union {
     struct {
-      varnumber_T start_col_nr;  ///< starting column number
-      varnumber_T end_col_nr;    ///< ending column number
+      uint64_t prefix;           ///< first bytes of the key, big-endian
+      size_t key_off;            ///< offset of the key in "sortkeys"
+      size_t key_len;            ///< length of the key
     } line;
     struct {
       varnumber_T value;         ///< value if sorting by integer
@@ -385,6 +390,22 @@ static int string_compare(const void *s1, const void *s2) FUNC_ATTR_NONNULL_ALL
   return sort_ic ? STRICMP(s1, s2) : strcmp(s1, s2);
 }
 
+/// @return  the first bytes of a sort key packed into an integer, such that
+///          comparing the integers orders keys like string_compare() without
+///          'l' does, as far as those bytes go.
+static uint64_t sort_key_prefix(const char *key, size_t len)
+{
+  uint64_t prefix = 0;
+  for (size_t i = 0; i < sizeof(prefix); i++) {
+    uint8_t c = i < len ? (uint8_t)key[i] : NUL;
+    if (sort_ic) {
+      c = (uint8_t)TOLOWER_LOC(c);
+    }
+    prefix = (prefix << 8) | c;
+  }
+  return prefix;
+}
+
 static int sort_compare(const void *s1, const void *s2)
 {
   sorti_T l1 = *(sorti_T *)s1;
@@ -416,18 +437,17 @@ static int sort_compare(const void *s1, const void *s2)
     result = l1.st_u.value_flt == l2.st_u.value_flt
              ? 0
              : l1.st_u.value_flt > l2.st_u.value_flt ? 1 : -1;
+  } else if (!sort_lc && l1.st_u.line.prefix != l2.st_u.line.prefix) {
+    result = l1.st_u.line.prefix > l2.st_u.line.prefix ? 1 : -1;
+  } else if (!sort_lc && (l1.st_u.line.key_len < sizeof(uint64_t)
+                          || l2.st_u.line.key_len < sizeof(uint64_t))) {
+    // Lines contain no NUL, thus equal prefixes with padding mean equal keys.
+    result = 0;
   } else {
-    // We need to copy one line into "sortbuf1", because there is no
-    // guarantee that the first pointer becomes invalid when obtaining the
-    // second one.
-    memcpy(sortbuf1, ml_get(l1.lnum) + l1.st_u.line.start_col_nr,
-           (size_t)(l1.st_u.line.end_col_nr - l1.st_u.line.start_col_nr + 1));
-    sortbuf1[l1.st_u.line.end_col_nr - l1.st_u.line.start_col_nr] = NUL;
-    memcpy(sortbuf2, ml_get(l2.lnum) + l2.st_u.line.start_col_nr,
-           (size_t)(l2.st_u.line.end_col_nr - l2.st_u.line.start_col_nr + 1));
-    sortbuf2[l2.st_u.line.end_col_nr - l2.st_u.line.start_col_nr] = NUL;
-
-    result = string_compare(sortbuf1, sortbuf2);
+    // Only compare what follows the prefix, unless sorting on locale.
+    size_t skip = sort_lc ? 0 : sizeof(uint64_t);
+    result = string_compare(sortkeys.items + l1.st_u.line.key_off + skip,
+                            sortkeys.items + l2.st_u.line.key_off + skip);
   }
 
   // If two lines have the same value, preserve the original line order.
@@ -456,7 +476,7 @@ void ex_sort(exarg_T *eap)
     return;
   }
   sortbuf1 = NULL;
-  sortbuf2 = NULL;
+  kv_init(sortkeys);
   regmatch.regprog = NULL;
   sorti_T *nrs = xmalloc(count * sizeof(sorti_T));
 
@@ -533,11 +553,12 @@ void ex_sort(exarg_T *eap)
   // sorting.
   sort_nr |= sort_what;
 
-  // Make an array with all line numbers.  This avoids having to copy all
-  // the lines into allocated memory.
-  // When sorting on strings "start_col_nr" is the offset in the line, for
-  // numbers sorting it's the number to sort on.  This means the pattern
-  // matching and number conversion only has to be done once per line.
+  // Make an array with all line numbers.
+  // When sorting on strings the part of the line to sort on is copied into
+  // "sortkeys" and its first bytes are stored as "prefix", for numbers
+  // sorting it's the number to sort on.  This means the pattern matching and
+  // number conversion only has to be done once per line, and most
+  // comparisons don't need to look at the text.
   // Also get the longest line length for allocating "sortbuf".
   for (linenr_T lnum = eap->line1; lnum <= eap->line2; lnum++) {
     char *s = ml_get(lnum);
@@ -602,9 +623,13 @@ void ex_sort(exarg_T *eap)
       }
       *s2 = c;
     } else {
-      // Store the column to sort at.
-      nrs[lnum - eap->line1].st_u.line.start_col_nr = start_col;
-      nrs[lnum - eap->line1].st_u.line.end_col_nr = end_col;
+      // Store the text to sort on.
+      size_t key_len = (size_t)(end_col - start_col);
+      nrs[lnum - eap->line1].st_u.line.prefix = sort_key_prefix(s + start_col, key_len);
+      nrs[lnum - eap->line1].st_u.line.key_off = kv_size(sortkeys);
+      nrs[lnum - eap->line1].st_u.line.key_len = key_len;
+      kv_concat_len(sortkeys, s + start_col, key_len);
+      kv_push(sortkeys, NUL);
     }
 
     nrs[lnum - eap->line1].lnum = lnum;
@@ -619,7 +644,6 @@ void ex_sort(exarg_T *eap)
 
   // Allocate a buffer that can hold the longest line.
   sortbuf1 = xmalloc((size_t)maxlen + 1);
-  sortbuf2 = xmalloc((size_t)maxlen + 1);
 
   // Sort the array of line numbers.  Note: can't be interrupted!
   qsort((void *)nrs, count, sizeof(sorti_T), sort_compare);
@@ -627,6 +651,8 @@ void ex_sort(exarg_T *eap)
   if (sort_abort) {
     goto sortend;
   }
+  // The keys are not needed anymore, release the memory before adding lines.
+  kv_destroy(sortkeys);
 
   bcount_t old_count = 0;
   bcount_t new_count = 0;
@@ -648,7 +674,7 @@ void ex_sort(exarg_T *eap)
     if (!unique || i == 0 || string_compare(s, sortbuf1) != 0) {
       // Copy the line into a buffer, it may become invalid in
       // ml_append(). And it's needed for "unique".
-      STRCPY(sortbuf1, s);
+      memcpy(sortbuf1, s, (size_t)bytelen);
       if (ml_append(lnum++, sortbuf1, 0, false) == FAIL) {
         break;
       }
@@ -692,7 +718,7 @@ void ex_sort(exarg_T *eap)
 sortend:
   xfree(nrs);
   xfree(sortbuf1);
-  xfree(sortbuf2);
+  kv_destroy(sortkeys);
   vim_regfree(regmatch.regprog);
   if (got_int) {
     emsg(_(e_interr));
@@ -4368,6 +4394,31 @@ static void global_exe_one(char *const cmd, const linenr_T lnum)
   }
 }
 
+/// @return  true if "cmd" deletes the line into the black hole register
+///          ("d _", "delete _", etc.).  Then consecutive marked lines can be
+///          deleted at once, without changing the result.
+static bool global_cmd_is_delete_blackhole(const char *cmd)
+{
+  const char *p = skipwhite(cmd);
+  while (*p == ':') {
+    p = skipwhite(p + 1);
+  }
+  const char *name = "delete";
+  size_t len = 0;
+  while (name[len] != NUL && p[len] == name[len]) {
+    len++;
+  }
+  if (len == 0 || ASCII_ISALPHA(p[len])) {
+    return false;
+  }
+  p = skipwhite(p + len);
+  if (*p != '_') {
+    return false;
+  }
+  p = skipwhite(p + 1);
+  return *p == NUL || (*p == '\n' && p[1] == NUL);
+}
+
 /// Execute a global command of the form:
 ///
 /// g/pattern/X : execute X on all lines where pattern matches
@@ -4507,9 +4558,31 @@ void global_exe(char *cmd)
   global_busy = 1;
   old_lcount = curbuf->b_ml.ml_line_count;
 
-  while (!got_int && (lnum = ml_firstmarked()) != 0 && global_busy == 1) {
-    global_exe_one(cmd, lnum);
-    os_breakcheck();
+  if (global_cmd_is_delete_blackhole(cmd)) {
+    // Delete each run of consecutive marked lines with one command, instead
+    // of saving undo, adjusting marks and redrawing for every single line.
+    char range_cmd[NUMBUFLEN + 20];
+    linenr_T next = ml_firstmarked();
+    while (!got_int && (lnum = next) != 0 && global_busy == 1) {
+      linenr_T end = lnum;
+      while ((next = ml_firstmarked()) == end + 1) {
+        end++;
+      }
+      vim_snprintf(range_cmd, sizeof(range_cmd), ".,.+%" PRIdLINENR "delete _", end - lnum);
+      linenr_T lcount = curbuf->b_ml.ml_line_count;
+      global_exe_one(range_cmd, lnum);
+      if (next != 0) {
+        // The mark of the next line was already taken, account for the
+        // deleted lines above it.
+        next -= lcount - curbuf->b_ml.ml_line_count;
+      }
+      os_breakcheck();
+    }
+  } else {
+    while (!got_int && (lnum = ml_firstmarked()) != 0 && global_busy == 1) {
+      global_exe_one(cmd, lnum);
+      os_breakcheck();
+    }
   }
 
   global_busy = 0;
@@ -1,20 +1,21 @@
 -- Script creates the following tables in unicode_tables.generated.h:
 --
--- 1. doublewidth and ambiguous tables: sorted list of non-overlapping closed
---    intervals. Codepoints in these intervals have double (W or F) or ambiguous
---    (A) east asian width respectively.
--- 2. combining table: same as the above, but characters inside are combining
---    characters (i.e. have general categories equal to Mn, Mc or Me).
--- 3. foldCase, toLower and toUpper tables used to convert characters to
+-- 1. foldCase, toLower and toUpper tables used to convert characters to
 --    folded/lower/upper variants. In these tables first two values are
---    character ranges: like in previous tables they are sorted and must be
---    non-overlapping. Third value means step inside the range: e.g. if it is
---    2 then interval applies only to first, third, fifth, … character in range.
---    Fourth value is number that should be added to the codepoint to yield
+--    character ranges: they are sorted and must be non-overlapping. Third
+--    value means step inside the range: e.g. if it is 2 then interval applies
+--    only to first, third, fifth, … character in range. Fourth value is
+--    number that should be added to the codepoint to yield
 --    folded/lower/upper codepoint.
--- 4. emoji_wide and emoji_all tables: sorted lists of non-overlapping closed
---    intervals of Emoji characters.  emoji_wide contains all the characters
---    which don't have ambiguous or double width, and emoji_all has all Emojis.
+-- 2. unicode_props_index and unicode_props_blocks: two-stage lookup table with
+--    a byte of kUProp* flags for every codepoint.  The index is indexed with
+--    the codepoint divided by 256 and yields the block holding the flags for
+--    those 256 codepoints.  Identical blocks are stored only once.  The flags
+--    tell whether a codepoint:
+--    - has double (W or F) or ambiguous (A) east asian width;
+--    - is a combining character (i.e. has general category Mn or Me);
+--    - is an Emoji, and an Emoji without ambiguous or double width;
+--    - is in the foldCase, toLower or toUpper table.
 if arg[1] == '--help' then
   print('Usage:')
   print('  gen_unicode_tables.lua unicode/ unicode_tables.generated.h')
@@ -90,15 +91,12 @@ local parse_emoji_props = function(emoji_fp)
 end
 
 local make_range = function(start, end_, step, add)
-  if step and add then
-    return ('  {0x%x, 0x%x, %d, %d},\n'):format(start, end_, step == 0 and -1 or step, add)
-  else
-    return ('  {0x%04x, 0x%04x},\n'):format(start, end_)
-  end
+  return ('  {0x%x, 0x%x, %d, %d},\n'):format(start, end_, step == 0 and -1 or step, add)
 end
 
 local build_convert_table = function(ut_fp, props, cond_func, nl_index, table_name)
   ut_fp:write('static const convertStruct ' .. table_name .. '[] = {\n')
+  local ret = {}
   local start = -1
   local end_ = -1
   local step = 0
@@ -115,6 +113,7 @@ local build_convert_table = function(ut_fp, props, cond_func, nl_index, table_na
         if start >= 0 then
           -- Produce previous range.
           ut_fp:write(make_range(start, end_, step, add))
+          table.insert(ret, { start, end_, step })
         end
         start = n
         end_ = n
@@ -125,8 +124,10 @@ local build_convert_table = function(ut_fp, props, cond_func, nl_index, table_na
   end
   if start >= 0 then
     ut_fp:write(make_range(start, end_, step, add))
+    table.insert(ret, { start, end_, step })
   end
   ut_fp:write('};\n')
+  return ret
 end
 
 local build_case_table = function(ut_fp, dataprops, table_name, index)
@@ -143,8 +144,8 @@ local build_fold_table = function(ut_fp, foldprops)
   return build_convert_table(ut_fp, foldprops, cond_func, 3, 'foldCase')
 end
 
-local build_combining_table = function(ut_fp, dataprops)
-  ut_fp:write('static const struct interval combining[] = {\n')
+local get_combining_ranges = function(dataprops)
+  local ret = {}
   local start = -1
   local end_ = -1
   for _, p in ipairs(dataprops) do
@@ -157,7 +158,7 @@ local build_combining_table = function(ut_fp, dataprops)
       else
         if start >= 0 then
           -- Produce previous range.
-          ut_fp:write(make_range(start, end_))
+          table.insert(ret, { start, end_ })
         end
         start = n
         end_ = n
@@ -165,13 +166,12 @@ local build_combining_table = function(ut_fp, dataprops)
     end
   end
   if start >= 0 then
-    ut_fp:write(make_range(start, end_))
+    table.insert(ret, { start, end_ })
   end
-  ut_fp:write('};\n')
+  return ret
 end
 
-local build_width_table = function(ut_fp, dataprops, widthprops, widths, table_name)
-  ut_fp:write('static const struct interval ' .. table_name .. '[] = {\n')
+local get_width_ranges = function(dataprops, widthprops, widths)
   local start = -1
   local end_ = -1
   local dataidx = 1
@@ -207,7 +207,6 @@ local build_width_table = function(ut_fp, dataprops, widthprops, widths, table_n
           -- Continue with the same range.
         else
           if start >= 0 then
-            ut_fp:write(make_range(start, end_))
             table.insert(ret, { start, end_ })
           end
           start = n
@@ -217,14 +216,12 @@ local build_width_table = function(ut_fp, dataprops, widthprops, widths, table_n
     end
   end
   if start >= 0 then
-    ut_fp:write(make_range(start, end_))
     table.insert(ret, { start, end_ })
   end
-  ut_fp:write('};\n')
   return ret
 end
 
-local build_emoji_table = function(ut_fp, emojiprops, doublewidth, ambiwidth)
+local get_emoji_ranges = function(emojiprops, doublewidth, ambiwidth)
   local emojiwidth = {}
   local emoji = {}
   for _, p in ipairs(emojiprops) do
@@ -277,15 +274,74 @@ local build_emoji_table = function(ut_fp, emojiprops, doublewidth, ambiwidth)
     end
   end
 
-  ut_fp:write('static const struct interval emoji_all[] = {\n')
-  for _, p in ipairs(emoji) do
-    ut_fp:write(make_range(p[1], p[2]))
+  return emoji, emojiwidth
+end
+
+local prop_flags = {
+  { 'kUPropDoubleWidth', 0x01 },
+  { 'kUPropAmbiguous', 0x02 },
+  { 'kUPropEmojiWide', 0x04 },
+  { 'kUPropEmoji', 0x08 },
+  { 'kUPropCombining', 0x10 },
+  { 'kUPropFold', 0x20 },
+  { 'kUPropToLower', 0x40 },
+  { 'kUPropToUpper', 0x80 },
+}
+local prop = {}
+for _, f in ipairs(prop_flags) do
+  prop[f[1]] = f[2]
+end
+
+-- Set "flag" in "props" for every codepoint in the ranges of "ranges".  The
+-- third value of a range, when present and not zero, is the step.
+local add_props = function(props, ranges, flag)
+  for _, r in ipairs(ranges) do
+    local step = (r[3] == nil or r[3] == 0) and 1 or r[3]
+    for c = r[1], r[2], step do
+      local v = props[c] or 0
+      if v % (flag * 2) < flag then
+        props[c] = v + flag
+      end
+    end
+  end
+end
+
+local build_props_table = function(ut_fp, props)
+  ut_fp:write('enum {\n')
+  for _, f in ipairs(prop_flags) do
+    ut_fp:write(('  %s = 0x%02x,\n'):format(f[1], f[2]))
   end
   ut_fp:write('};\n')
 
-  ut_fp:write('static const struct interval emoji_wide[] = {\n')
-  for _, p in ipairs(emojiwidth) do
-    ut_fp:write(make_range(p[1], p[2]))
+  local index = {}
+  local blocks = {}
+  local block_ids = {}
+  for b = 0, math.floor(0x10ffff / 256) do
+    local vals = {}
+    for i = 0, 255 do
+      vals[#vals + 1] = ('0x%02x'):format(props[b * 256 + i] or 0)
+    end
+    local block = table.concat(vals, ',')
+    if not block_ids[block] then
+      table.insert(blocks, vals)
+      block_ids[block] = #blocks - 1
+    end
+    table.insert(index, block_ids[block])
+  end
+
+  ut_fp:write('static const uint16_t unicode_props_index[] = {\n')
+  for i = 1, #index, 16 do
+    ut_fp:write('  ' .. table.concat(index, ', ', i, math.min(i + 15, #index)) .. ',\n')
+  end
+  ut_fp:write('};\n')
+
+  ut_fp:write('static const uint8_t unicode_props_blocks[][256] = {\n')
+  for _, vals in ipairs(blocks) do
+    ut_fp:write('  {\n')
+    for i = 1, #vals, 16 do
+      ut_fp:write('    ' .. table.concat(vals, ', ', i, i + 15) .. ',\n')
+    end
+    ut_fp:write('  },\n')
   end
   ut_fp:write('};\n')
 end
@@ -296,28 +352,35 @@ ud_fp:close()
 
 local ut_fp = io.open(utf_tables_fname, 'w')
 
-build_case_table(ut_fp, dataprops, 'Lower', 14)
-build_case_table(ut_fp, dataprops, 'Upper', 13)
-build_combining_table(ut_fp, dataprops)
+local props = {}
+
+add_props(props, build_case_table(ut_fp, dataprops, 'Lower', 14), prop.kUPropToLower)
+add_props(props, build_case_table(ut_fp, dataprops, 'Upper', 13), prop.kUPropToUpper)
+add_props(props, get_combining_ranges(dataprops), prop.kUPropCombining)
 
 local cf_fp = io.open(casefolding_fname, 'r')
 local foldprops = parse_fold_props(cf_fp)
 cf_fp:close()
 
-build_fold_table(ut_fp, foldprops)
+add_props(props, build_fold_table(ut_fp, foldprops), prop.kUPropFold)
 
 local eaw_fp = io.open(eastasianwidth_fname, 'r')
 local widthprops = parse_width_props(eaw_fp)
 eaw_fp:close()
 
-local doublewidth =
-  build_width_table(ut_fp, dataprops, widthprops, { W = true, F = true }, 'doublewidth')
-local ambiwidth = build_width_table(ut_fp, dataprops, widthprops, { A = true }, 'ambiguous')
+local doublewidth = get_width_ranges(dataprops, widthprops, { W = true, F = true })
+local ambiwidth = get_width_ranges(dataprops, widthprops, { A = true })
+add_props(props, doublewidth, prop.kUPropDoubleWidth)
+add_props(props, ambiwidth, prop.kUPropAmbiguous)
 
 local emoji_fp = io.open(emoji_fname, 'r')
 local emojiprops = parse_emoji_props(emoji_fp)
 emoji_fp:close()
 
-build_emoji_table(ut_fp, emojiprops, doublewidth, ambiwidth)
+local emoji, emojiwidth = get_emoji_ranges(emojiprops, doublewidth, ambiwidth)
+add_props(props, emojiwidth, prop.kUPropEmojiWide)
+add_props(props, emoji, prop.kUPropEmoji)
+
+build_props_table(ut_fp, props)
 
 ut_fp:close()
@@ -85,7 +85,10 @@ EXTERN struct nvim_stats_s {
   int64_t fsync;
   int64_t redraw;
   int16_t log_skip;  // How many logs were tried and skipped before log_init.
-} g_stats INIT( = { 0, 0, 0 });
+  int64_t spawn;  // Number of processes started.
+  int64_t spawn_direct;  // Shell commands that were run without 'shell'.
+  uint64_t spawn_time;  // Total time spent starting processes, in nanoseconds.
+} g_stats INIT( = { 0, 0, 0, 0, 0, 0 });
 
 // Values for "starting".
 #define NO_SCREEN       2       // no screen updating yet
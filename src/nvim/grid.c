@@ -682,12 +682,39 @@ void grid_put_linebuf(ScreenGrid *grid, int row, int coloff, int col, int endcol
     }
   }
 
+  if (endcol > col) {
+    memcpy(grid->vcols + off_to + col, linebuf_vcol + col,
+           (size_t)(endcol - col) * sizeof(colnr_T));
+  }
+
+  // Skip the start and end of the line that are already in the grid, so that
+  // the loop below only goes over the part that may have changed.
+  int dirty_col = col;
+  int dirty_endcol = endcol;
+  if (!exmode_active && !(rdb_flags & RDB_NODELTA)) {
+    while (dirty_col < dirty_endcol
+           && linebuf_char[dirty_col] == grid->chars[off_to + (size_t)dirty_col]
+           && linebuf_attr[dirty_col] == grid->attrs[off_to + (size_t)dirty_col]) {
+      dirty_col++;
+    }
+    while (dirty_endcol > dirty_col
+           && linebuf_char[dirty_endcol - 1] == grid->chars[off_to + (size_t)dirty_endcol - 1]
+           && linebuf_attr[dirty_endcol - 1] == grid->attrs[off_to + (size_t)dirty_endcol - 1]) {
+      dirty_endcol--;
+    }
+    // Don't start at the right half of a double-width character.
+    if (dirty_col > col && dirty_col < endcol && linebuf_char[dirty_col] == 0) {
+      dirty_col--;
+    }
+    col = dirty_col;
+  }
+
   redraw_next = grid_char_needs_redraw(grid, col, off_to + (size_t)col, endcol - col);
 
   int start_dirty = -1;
   int end_dirty = 0;
 
-  while (col < endcol) {
+  while (col < dirty_endcol) {
     int char_cells = 1;  // 1: normal char
                          // 2: occupies two display cells
     if (col + 1 < endcol && linebuf_char[col + 1] == 0) {
@@ -727,11 +754,6 @@ void grid_put_linebuf(ScreenGrid *grid, int row, int coloff, int col, int endcol
       }
     }
 
-    grid->vcols[off] = linebuf_vcol[col];
-    if (char_cells == 2) {
-      grid->vcols[off + 1] = linebuf_vcol[col + 1];
-    }
-
     col += char_cells;
   }
 
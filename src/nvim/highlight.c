@@ -5,6 +5,7 @@
 #include <lauxlib.h>
 #include <string.h>
 
+#include "klib/kvec.h"
 #include "nvim/api/keysets_defs.h"
 #include "nvim/api/private/defs.h"
 #include "nvim/api/private/dispatch.h"
@@ -46,6 +47,30 @@ static Set(cstr_t) urls = SET_INIT;
 
 #define attr_entry(i) attr_entries.keys[i]
 
+/// Number of entries in the caches in front of the combine and blend maps.
+/// Must be a power of two.
+#define HL_L1_SIZE 256
+
+/// Direct-mapped cache of the most recent lookups in one of the maps above.
+/// Combining and blending is done for every screen cell, and usually for
+/// only a few different attributes at a time.
+typedef struct {
+  int tag;  ///< key in the map
+  int id;   ///< attribute, zero when unused
+} HlL1Entry;
+
+static HlL1Entry combine_l1[HL_L1_SIZE];
+static HlL1Entry blend_l1[HL_L1_SIZE];
+static HlL1Entry blendthrough_l1[HL_L1_SIZE];
+
+/// Number of attribute entries above which hl_attr_compact_if_large()
+/// rebuilds the table.
+#define HL_ATTR_COMPACT_MIN (MAX_TYPENR / 4)
+static size_t hl_attr_compact_limit = HL_ATTR_COMPACT_MIN;
+/// The table was rebuilt by hl_attr_compact_if_large() and has not been
+/// checked since then.
+static bool hl_attr_compacted = false;
+
 /// highlight entries private to a namespace
 static Map(ColorKey, ColorItem) ns_hls;
 typedef int NSHlAttr[HLF_COUNT + 1];
@@ -539,12 +564,40 @@ void clear_hl_tables(bool reinit)
   });
 
   if (reinit) {
+    // Remember the attributes of namespace highlights, their attr_id must be
+    // defined again in the new table.
+    kvec_t(HlAttrs) ns_attrs = KV_INITIAL_VALUE;
+    ColorItem item;
+    map_foreach_value(&ns_hls, item, {
+      if (item.attr_id > 0) {
+        kv_push(ns_attrs, attr_entry(item.attr_id).attr);
+      }
+    });
+
+    hl_attr_generation++;
     set_clear(HlEntry, &attr_entries);
     highlight_init();
+
     map_clear(int, &combine_attr_entries);
     map_clear(int, &blend_attr_entries);
     map_clear(int, &blendthrough_attr_entries);
+    hl_l1_clear(combine_l1);
+    hl_l1_clear(blend_l1);
+    hl_l1_clear(blendthrough_l1);
     set_clear(cstr_t, &urls);
+
+    size_t i = 0;
+    ColorKey key;
+    map_foreach_key(&ns_hls, key, {
+      ColorItem *it = map_ref(ColorKey, ColorItem)(&ns_hls, key, NULL);
+      if (it->attr_id > 0) {
+        HlAttrs attrs = kv_A(ns_attrs, i++);
+        attrs.url = -1;
+        it->attr_id = hl_get_syn_attr(key.ns_id, key.syn_id, attrs);
+      }
+    });
+    kv_destroy(ns_attrs);
+
     memset(highlight_attr_last, -1, sizeof(highlight_attr_last));
     highlight_attr_set_all();
     highlight_changed();
@@ -559,10 +612,49 @@ void clear_hl_tables(bool reinit)
   }
 }
 
+/// Rebuild the attribute table when it has grown large, so that the
+/// attributes of combinations that are no longer drawn are dropped.  Unlike
+/// the reset in get_attr_entry() when the table is full, this is done before
+/// updating the screen, not halfway drawing it.
+///
+/// @return  true when the table was rebuilt, the screen must be cleared and
+///          redrawn.
+bool hl_attr_compact_if_large(void)
+{
+  size_t const size = set_size(&attr_entries);
+  if (hl_attr_compacted) {
+    // This is the number of attributes needed to draw the screen.  When the
+    // table filled up because most of them are in use, wait until it has
+    // grown well beyond that before trying again.
+    hl_attr_compacted = false;
+    hl_attr_compact_limit = MAX(HL_ATTR_COMPACT_MIN, 2 * size);
+  }
+  if (size < hl_attr_compact_limit) {
+    return false;
+  }
+  clear_hl_tables(true);
+  hl_attr_compacted = true;
+  return true;
+}
+
+/// Clear a cache in front of one of the combine or blend maps.
+static void hl_l1_clear(HlL1Entry *l1)
+{
+  memset(l1, 0, HL_L1_SIZE * sizeof(*l1));
+}
+
+/// Get the entry in cache "l1" where key "tag" goes.
+static HlL1Entry *hl_l1_entry(HlL1Entry *l1, int tag)
+{
+  return &l1[((uint32_t)tag * 2654435761U) >> 24 & (HL_L1_SIZE - 1)];
+}
+
 void hl_invalidate_blends(void)
 {
   map_clear(int, &blend_attr_entries);
   map_clear(int, &blendthrough_attr_entries);
+  hl_l1_clear(blend_l1);
+  hl_l1_clear(blendthrough_l1);
   highlight_changed();
   update_window_hl(curwin, true);
 }
@@ -593,8 +685,13 @@ int hl_combine_attr(int char_attr, int prim_attr)
 
   // TODO(bfredl): could use a struct for clearer intent.
   int combine_tag = (char_attr << 16) + prim_attr;
+  HlL1Entry *const l1 = hl_l1_entry(combine_l1, combine_tag);
+  if (l1->id > 0 && l1->tag == combine_tag) {
+    return l1->id;
+  }
   int id = map_get(int, int)(&combine_attr_entries, combine_tag);
   if (id > 0) {
+    *l1 = (HlL1Entry){ .tag = combine_tag, .id = id };
     return id;
   }
 
@@ -655,6 +752,7 @@ int hl_combine_attr(int char_attr, int prim_attr)
                                  .id1 = char_attr, .id2 = prim_attr });
   if (id > 0) {
     map_put(int, int)(&combine_attr_entries, combine_tag, id);
+    *l1 = (HlL1Entry){ .tag = combine_tag, .id = id };
   }
 
   return id;
@@ -712,8 +810,13 @@ int hl_blend_attrs(int back_attr, int front_attr, bool *through)
   Map(int, int) *map = (*through
                         ? &blendthrough_attr_entries
                         : &blend_attr_entries);
+  HlL1Entry *const l1 = hl_l1_entry(*through ? blendthrough_l1 : blend_l1, combine_tag);
+  if (l1->id > 0 && l1->tag == combine_tag) {
+    return l1->id;
+  }
   int id = map_get(int, int)(map, combine_tag);
   if (id > 0) {
+    *l1 = (HlL1Entry){ .tag = combine_tag, .id = id };
     return id;
   }
 
@@ -761,6 +864,7 @@ int hl_blend_attrs(int back_attr, int front_attr, bool *through)
                                  .id1 = back_attr, .id2 = front_attr });
   if (id > 0) {
     map_put(int, int)(map, combine_tag, id);
+    *l1 = (HlL1Entry){ .tag = combine_tag, .id = id };
   }
   return id;
 }
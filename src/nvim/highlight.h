@@ -97,6 +97,10 @@ EXTERN NS ns_hl_active INIT( = 0);  // currently active/cached namespace
 
 EXTERN int *hl_attr_active INIT( = highlight_attr);
 
+/// Incremented whenever the attribute table is reset and previously returned
+/// attr ids become invalid, so that caches of attr ids can be discarded.
+EXTERN int hl_attr_generation INIT( = 0);
+
 // Enums need a typecast to be used as array index.
 #define HL_ATTR(n)      hl_attr_active[(int)(n)]
 
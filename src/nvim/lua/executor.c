@@ -556,6 +556,18 @@ int nlua_get_global_ref_count(void)
   return nlua_global_refs->ref_count;
 }
 
+/// Add the memory of the global Lua state to "gauge", counting the references
+/// held by Nvim.
+void nlua_mem_usage(MemGauge *gauge)
+{
+  if (global_lstate == NULL) {
+    return;
+  }
+  gauge->count += (size_t)nlua_global_refs->ref_count;
+  gauge->bytes += (size_t)lua_gc(global_lstate, LUA_GCCOUNT, 0) * 1024
+                  + (size_t)lua_gc(global_lstate, LUA_GCCOUNTB, 0);
+}
+
 static void nlua_common_vim_init(lua_State *lstate, bool is_thread, bool is_standalone)
   FUNC_ATTR_NONNULL_ARG(1)
 {
@@ -26,6 +26,8 @@
 #include "nvim/memory.h"
 #include "nvim/pos_defs.h"
 #include "nvim/strings.h"
+#include "nvim/trace.h"
+#include "nvim/trace_defs.h"
 #include "nvim/types_defs.h"
 
 #define TS_META_PARSER "treesitter_parser"
@@ -332,8 +334,9 @@ static int parser_parse(lua_State *L)
   size_t len;
   const char *str;
   handle_T bufnr;
-  buf_T *buf;
+  buf_T *buf = NULL;
   TSInput input;
+  uint64_t trace_start = trace_begin();
 
   // This switch is necessary because of the behavior of lua_isstring, that
   // consider numbers as strings...
@@ -363,6 +366,7 @@ static int parser_parse(lua_State *L)
   default:
     return luaL_argerror(L, 3, "expected either string or buffer handle");
   }
+  trace_end(kTraceTsParse, trace_start, buf ? buf->handle : 0, old_tree != NULL);
 
   bool include_bytes = (lua_gettop(L) >= 4) && lua_toboolean(L, 4);
 
@@ -157,7 +157,7 @@ static void mapblock_free(mapblock_T **mpp)
   }
   xfree(mp->m_desc);
   *mpp = mp->m_next;
-  xfree(mp);
+  pool_free(mp, sizeof(mapblock_T));
 }
 
 /// put characters to represent the map mode in a string buffer
@@ -500,7 +500,7 @@ static void map_add(buf_T *buf, mapblock_T **map_table, mapblock_T **abbr_table,
                     MapArguments *args, int noremap, int mode, bool is_abbr, scid_T sid,
                     linenr_T lnum, bool simplified)
 {
-  mapblock_T *mp = xcalloc(1, sizeof(mapblock_T));
+  mapblock_T *mp = pool_calloc(sizeof(mapblock_T));
 
   // If CTRL-C has been mapped, don't always use it for Interrupting.
   if (*keys == Ctrl_C) {
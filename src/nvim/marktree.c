@@ -54,6 +54,7 @@
 #include "nvim/map_defs.h"
 #include "nvim/marktree.h"
 #include "nvim/memory.h"
+#include "nvim/memory_defs.h"
 #include "nvim/pos_defs.h"
 // only for debug functions
 #include "nvim/api/private/defs.h"
@@ -1316,6 +1317,29 @@ static void marktree_free_node(MarkTree *b, MTNode *x)
   b->n_nodes--;
 }
 
+/// Add the marks of "b" and the memory of its nodes to "gauge".
+void marktree_mem_usage(MarkTree *b, MemGauge *gauge)
+{
+  gauge->count += b->n_keys;
+  gauge->bytes += map_size(b->id2node) * (sizeof(uint64_t) + sizeof(MTNode *));
+  if (b->root) {
+    marktree_mem_usage_node(b->root, gauge);
+  }
+}
+
+static void marktree_mem_usage_node(MTNode *x, MemGauge *gauge)
+{
+  gauge->bytes += x->level ? ILEN : sizeof(MTNode);
+  if (kv_max(x->intersect) > ARRAY_SIZE(x->intersect.init_array)) {
+    gauge->bytes += kv_max(x->intersect) * sizeof(uint64_t);
+  }
+  if (x->level) {
+    for (int i = 0; i < x->n + 1; i++) {
+      marktree_mem_usage_node(x->ptr[i], gauge);
+    }
+  }
+}
+
 /// @param itr iterator is invalid after call
 void marktree_move(MarkTree *b, MarkTreeIter *itr, int row, int col)
 {
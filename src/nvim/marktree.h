@@ -7,6 +7,7 @@
 #include "nvim/buffer_defs.h"
 #include "nvim/decoration_defs.h"
 #include "nvim/marktree_defs.h"  // IWYU pragma: keep
+#include "nvim/memory_defs.h"  // IWYU pragma: keep
 #include "nvim/pos_defs.h"  // IWYU pragma: keep
 // only for debug functions:
 #include "nvim/api/private/defs.h"  // IWYU pragma: keep
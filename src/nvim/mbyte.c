@@ -54,6 +54,7 @@
 #include "nvim/keycodes.h"
 #include "nvim/macros_defs.h"
 #include "nvim/mark.h"
+#include "nvim/math.h"
 #include "nvim/mbyte.h"
 #include "nvim/mbyte_defs.h"
 #include "nvim/memline.h"
@@ -469,14 +470,25 @@ static bool intable(const struct interval *table, size_t n_items, int c)
   return false;
 }
 
+/// Return the kUProp* flags of character "c": a single lookup in the
+/// two-stage table generated by gen_unicode_tables.lua.
+static uint8_t utf_props(int c)
+  FUNC_ATTR_PURE
+{
+  if (c < 0 || c > 0x10ffff) {
+    return 0;
+  }
+  return unicode_props_blocks[unicode_props_index[c >> 8]][c & 0xff];
+}
+
 /// For UTF-8 character "c" return 2 for a double-width character, 1 for others.
 /// Returns 4 or 6 for an unprintable character.
 /// Is only correct for characters >= 0x80.
 /// When p_ambw is "double", return 2 for a character with East Asian Width
 /// class 'A'(mbiguous).
 ///
-/// @note Tables `doublewidth` and `ambiguous` are generated by
-///       gen_unicode_tables.lua, which must be manually invoked as needed.
+/// @note The width flags of utf_props() are generated by
+///       gen_unicode_tables.lua from EastAsianWidth.txt and emoji-data.txt.
 int utf_char2cells(int c)
 {
   if (c < 0x80) {
@@ -494,13 +506,14 @@ int utf_char2cells(int c)
     return n;
   }
 
-  if (intable(doublewidth, ARRAY_SIZE(doublewidth), c)) {
+  const uint8_t props = utf_props(c);
+  if (props & kUPropDoubleWidth) {
     return 2;
   }
-  if (p_emoji && intable(emoji_wide, ARRAY_SIZE(emoji_wide), c)) {
+  if (p_emoji && (props & kUPropEmojiWide)) {
     return 2;
   }
-  if (*p_ambw == 'd' && intable(ambiguous, ARRAY_SIZE(ambiguous), c)) {
+  if (*p_ambw == 'd' && (props & kUPropAmbiguous)) {
     return 2;
   }
 
@@ -625,13 +638,7 @@ int utf_ptr2cells_len(const char *p, int size)
 /// @return The number of cells occupied by string `str`
 size_t mb_string2cells(const char *str)
 {
-  size_t clen = 0;
-
-  for (const char *p = str; *p != NUL; p += utfc_ptr2len(p)) {
-    clen += (size_t)utf_ptr2cells(p);
-  }
-
-  return clen;
+  return mb_string2cells_len(str, strlen(str));
 }
 
 /// Get the number of cells occupied by string `str` with maximum length `size`
@@ -644,9 +651,17 @@ size_t mb_string2cells_len(const char *str, size_t size)
   FUNC_ATTR_NONNULL_ARG(1)
 {
   size_t clen = 0;
+  const char *const end = str + strnlen(str, size);
 
-  for (const char *p = str; *p != NUL && p < str + size;
+  for (const char *p = str; p < end;
        p += utfc_ptr2len_len(p, (int)size + (int)(p - str))) {
+    // Skip over a run of printable ASCII at once.
+    size_t n = ascii_printable_len(p, (size_t)(end - p));
+    clen += n;
+    p += n;
+    if (p >= end) {
+      break;
+    }
     clen += (size_t)utf_ptr2cells(p);
   }
 
@@ -1088,7 +1103,7 @@ int utf_char2bytes(const int c, char *const buf)
 /// Returns false for negative values.
 bool utf_iscomposing(int c)
 {
-  return intable(combining, ARRAY_SIZE(combining), c);
+  return utf_props(c) & kUPropCombining;
 }
 
 #ifdef __SSE2__
@@ -1151,6 +1166,42 @@ bool utf_printable(int c)
 
 #endif
 
+/// Return the number of bytes at the start of "p[len]" that are printable
+/// ASCII characters, from space to '~', which take one cell each.
+///
+/// When the run is followed by a multi-byte character its last byte is not
+/// included, that character may be composing and belong to it.
+size_t ascii_printable_len(const char *p, size_t len)
+  FUNC_ATTR_PURE FUNC_ATTR_NONNULL_ALL
+{
+  size_t n = 0;
+#ifdef __SSE2__
+  // As signed bytes printable ASCII is above 0x1f and below 0x7f, bytes of
+  // multi-byte characters are negative.
+  __m128i const lo = _mm_set1_epi8(0x1f);
+  __m128i const hi = _mm_set1_epi8(0x7f);
+  for (; n + 16 <= len; n += 16) {
+    __m128i const v = _mm_loadu_si128((const __m128i *)(p + n));
+    int const mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(v, lo),
+                                                     _mm_cmplt_epi8(v, hi)));
+    if (mask != 0xffff) {
+      n += (size_t)xctz((uint64_t)(~mask & 0xffff));
+      goto done;
+    }
+  }
+#endif
+  while (n < len && (uint8_t)p[n] >= 0x20 && (uint8_t)p[n] < 0x7f) {
+    n++;
+  }
+#ifdef __SSE2__
+done:
+#endif
+  if (n > 0 && n < len && (uint8_t)p[n] >= 0x80) {
+    n--;
+  }
+  return n;
+}
+
 // Get class of a Unicode character.
 // 0: white space
 // 1: punctuation
@@ -1256,7 +1307,7 @@ int utf_class_tab(const int c, const uint64_t *const chartab)
   }
 
   // emoji
-  if (intable(emoji_all, ARRAY_SIZE(emoji_all), c)) {
+  if (utf_props(c) & kUPropEmoji) {
     return 3;
   }
 
@@ -1278,8 +1329,7 @@ int utf_class_tab(const int c, const uint64_t *const chartab)
 
 bool utf_ambiguous_width(int c)
 {
-  return c >= 0x80 && (intable(ambiguous, ARRAY_SIZE(ambiguous), c)
-                       || intable(emoji_all, ARRAY_SIZE(emoji_all), c));
+  return c >= 0x80 && (utf_props(c) & (kUPropAmbiguous | kUPropEmoji));
 }
 
 // Generic conversion function for case operations.
@@ -1316,6 +1366,9 @@ int utf_fold(int a)
     // be fast for ASCII
     return a >= 0x41 && a <= 0x5a ? a + 32 : a;
   }
+  if (!(utf_props(a) & kUPropFold)) {
+    return a;
+  }
   return utf_convert(a, foldCase, ARRAY_SIZE(foldCase));
 }
 
@@ -1346,6 +1399,9 @@ int mb_toupper(int a)
   }
 
   // For any other characters use the above mapping table.
+  if (!(utf_props(a) & kUPropToUpper)) {
+    return a;
+  }
   return utf_convert(a, toUpper, ARRAY_SIZE(toUpper));
 }
 
@@ -1374,6 +1430,9 @@ int mb_tolower(int a)
   }
 
   // For any other characters use the above mapping table.
+  if (!(utf_props(a) & kUPropToLower)) {
+    return a;
+  }
   return utf_convert(a, toLower, ARRAY_SIZE(toLower));
 }
 
@@ -2728,6 +2787,24 @@ typedef struct {
 static cw_interval_T *cw_table = NULL;
 static size_t cw_table_size = 0;
 
+/// Bitmap of the blocks of 256 characters that have an entry in "cw_table",
+/// so that cw_value() doesn't search the table for other characters.
+static uint64_t cw_blocks[((0x10ffff >> 8) >> 6) + 1];
+
+/// Set "cw_table" and update "cw_blocks" for it.
+static void cw_table_set(cw_interval_T *table, size_t size)
+{
+  cw_table = table;
+  cw_table_size = size;
+  memset(cw_blocks, 0, sizeof(cw_blocks));
+  for (size_t i = 0; i < size; i++) {
+    const int64_t last = MIN(table[i].last, 0x10ffff);
+    for (int64_t b = table[i].first >> 8; b <= last >> 8; b++) {
+      cw_blocks[b >> 6] |= (uint64_t)1 << (b & 63);
+    }
+  }
+}
+
 /// Return the value of the cellwidth table for the character `c`.
 ///
 /// @param c The source character.
@@ -2738,6 +2815,11 @@ static int cw_value(int c)
     return 0;
   }
 
+  // quick check for characters in blocks without an entry
+  if (c >= 0 && c <= 0x10ffff && !(cw_blocks[c >> 14] & ((uint64_t)1 << ((c >> 8) & 63)))) {
+    return 0;
+  }
+
   // first quick check for Latin1 etc. characters
   if (c < cw_table[0].first) {
     return 0;
@@ -2780,8 +2862,7 @@ void f_setcellwidths(typval_T *argvars, typval_T *rettv, EvalFuncData fptr)
   if (tv_list_len(l) == 0) {
     // Clearing the table.
     xfree(cw_table);
-    cw_table = NULL;
-    cw_table_size = 0;
+    cw_table_set(NULL, 0);
     return;
   }
 
@@ -2864,16 +2945,14 @@ void f_setcellwidths(typval_T *argvars, typval_T *rettv, EvalFuncData fptr)
 
   cw_interval_T *const cw_table_save = cw_table;
   const size_t cw_table_size_save = cw_table_size;
-  cw_table = table;
-  cw_table_size = (size_t)tv_list_len(l);
+  cw_table_set(table, (size_t)tv_list_len(l));
 
   // Check that the new value does not conflict with 'listchars' or
   // 'fillchars'.
   const char *const error = check_chars_options();
   if (error != NULL) {
     emsg(_(error));
-    cw_table = cw_table_save;
-    cw_table_size = cw_table_size_save;
+    cw_table_set(cw_table_save, cw_table_size_save);
     xfree(table);
     return;
   }
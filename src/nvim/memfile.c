@@ -54,6 +54,7 @@
 #include "nvim/memfile_defs.h"
 #include "nvim/memline.h"
 #include "nvim/memory.h"
+#include "nvim/memory_defs.h"
 #include "nvim/message.h"
 #include "nvim/os/fs.h"
 #include "nvim/os/fs_defs.h"
@@ -61,6 +62,8 @@
 #include "nvim/os/os_defs.h"
 #include "nvim/path.h"
 #include "nvim/pos_defs.h"
+#include "nvim/trace.h"
+#include "nvim/trace_defs.h"
 #include "nvim/types_defs.h"
 #include "nvim/vim_defs.h"
 
@@ -384,6 +387,8 @@ int mf_sync(memfile_T *mfp, int flags)
     return FAIL;
   }
 
+  uint64_t trace_start = trace_begin();
+
   // Only a CTRL-C while writing will break us here, not one typed previously.
   got_int = false;
 
@@ -435,6 +440,7 @@ int mf_sync(memfile_T *mfp, int flags)
 
   got_int |= got_int_save;
 
+  trace_end(kTraceMfSync, trace_start, flags, status);
   return status;
 }
 
@@ -451,6 +457,19 @@ void mf_set_dirty(memfile_T *mfp)
   mfp->mf_dirty = MF_DIRTY_YES;
 }
 
+/// Add the blocks of memfile "mfp" that are in memory to "gauge".
+void mf_mem_usage(memfile_T *mfp, MemGauge *gauge)
+{
+  bhdr_T *hp;
+  map_foreach_value(&mfp->mf_hash, hp, {
+    gauge->count++;
+    gauge->bytes += sizeof(bhdr_T);
+    if (hp->bh_data != NULL) {
+      gauge->bytes += (size_t)hp->bh_page_count * mfp->mf_page_size;
+    }
+  })
+}
+
 /// Release as many blocks as possible.
 ///
 /// Used in case of out of memory
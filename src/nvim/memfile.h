@@ -1,6 +1,7 @@
 #pragma once
 
 #include "nvim/memfile_defs.h"  // IWYU pragma: keep
+#include "nvim/memory_defs.h"  // IWYU pragma: keep
 #include "nvim/types_defs.h"  // IWYU pragma: keep
 
 /// flags for mf_sync()
@@ -13,6 +13,7 @@
 #include "nvim/api/ui.h"
 #include "nvim/arglist.h"
 #include "nvim/ascii_defs.h"
+#include "nvim/assert_defs.h"
 #include "nvim/buffer_defs.h"
 #include "nvim/buffer_updates.h"
 #include "nvim/channel.h"
@@ -713,6 +714,165 @@ char *arena_memdupz(Arena *arena, const char *buf, size_t size)
   return mem;
 }
 
+// Pools for small objects that are allocated and freed often, like list
+// items.  Objects are grouped in size classes of POOL_ALIGN bytes, carved out
+// of slabs and put on a free list of their class when freed.  The memory is
+// only given back to the system by free_all_mem(), until then it is reused
+// for any object of the same size class.
+//
+// With ASAN the objects that are not allocated are poisoned, so that a use
+// after pool_free() or a pool_free() with a too large size is reported.
+// When running unit tests every object is allocated separately, so that
+// allocation logging sees them.
+
+#define POOL_ALIGN 16
+#define POOL_CLASS_COUNT 16  // up to 256 bytes
+#define POOL_SLAB_SIZE (16 * ARENA_BLOCK_SIZE)
+
+#ifdef UNIT_TESTING
+# define POOL_PASSTHROUGH
+#endif
+
+#if __has_feature(address_sanitizer) || defined(__SANITIZE_ADDRESS__)
+# include <sanitizer/asan_interface.h>
+# define POOL_POISON(ptr, size) ASAN_POISON_MEMORY_REGION(ptr, size)
+# define POOL_UNPOISON(ptr, size) ASAN_UNPOISON_MEMORY_REGION(ptr, size)
+# define POOL_IS_POISONED(ptr, size) (__asan_region_is_poisoned(ptr, size) != NULL)
+#else
+# define POOL_POISON(ptr, size) ((void)(ptr), (void)(size))
+# define POOL_UNPOISON(ptr, size) ((void)(ptr), (void)(size))
+# define POOL_IS_POISONED(ptr, size) ((void)(ptr), (void)(size), false)
+#endif
+
+typedef struct {
+  void *free_list;  ///< freed objects, linked through their first word
+  char *next;       ///< next unused object in the newest slab
+  char *end;        ///< end of the newest slab
+  char *slab_list;  ///< all slabs, linked through their first word
+  size_t live;      ///< number of allocated objects
+  size_t slabs;     ///< number of slabs
+} MemPool;
+
+static MemPool mem_pools[POOL_CLASS_COUNT];
+
+#define POOL_OBJ_SIZE(size) (((size) + POOL_ALIGN - 1) & ~(size_t)(POOL_ALIGN - 1))
+
+#ifndef POOL_PASSTHROUGH
+static MemPool *pool_get(size_t size)
+{
+  assert(size > 0 && size <= POOL_CLASS_COUNT * POOL_ALIGN);
+  return &mem_pools[(size - 1) / POOL_ALIGN];
+}
+#endif
+
+/// Allocate an object of "size" bytes from the pool of its size class.
+///
+/// @param size  must be at most 256 bytes.
+/// @return  uninitialized memory, free it with pool_free() and the same size.
+void *pool_alloc(size_t size)
+  FUNC_ATTR_MALLOC FUNC_ATTR_NONNULL_RET
+{
+#ifdef POOL_PASSTHROUGH
+  return xmalloc(size);
+#else
+  MemPool *pool = pool_get(size);
+  size_t obj_size = POOL_OBJ_SIZE(size);
+  pool->live++;
+  if (pool->free_list != NULL) {
+    void *ret = pool->free_list;
+    POOL_UNPOISON(ret, obj_size);
+    pool->free_list = *(void **)ret;
+    return ret;
+  }
+
+  if (pool->next == NULL || pool->next + obj_size > pool->end) {
+    // The first POOL_ALIGN bytes link the slab to the previous one.
+    char *slab = xmalloc(POOL_SLAB_SIZE);
+    *(char **)slab = pool->slab_list;
+    pool->slab_list = slab;
+    pool->next = slab + POOL_ALIGN;
+    pool->end = slab + POOL_SLAB_SIZE;
+    pool->slabs++;
+    POOL_POISON(pool->next, (size_t)(pool->end - pool->next));
+  }
+  void *ret = pool->next;
+  pool->next += obj_size;
+  POOL_UNPOISON(ret, obj_size);
+  return ret;
+#endif
+}
+
+/// Like pool_alloc(), but the memory is cleared.
+void *pool_calloc(size_t size)
+  FUNC_ATTR_MALLOC FUNC_ATTR_NONNULL_RET
+{
+  return memset(pool_alloc(size), 0, size);
+}
+
+/// Return an object allocated with pool_alloc() to its pool.
+///
+/// @param size  the size "ptr" was allocated with.
+void pool_free(void *ptr, size_t size)
+{
+  if (ptr == NULL) {
+    return;
+  }
+#ifdef POOL_PASSTHROUGH
+  xfree(ptr);
+#else
+  MemPool *pool = pool_get(size);
+  size_t obj_size = POOL_OBJ_SIZE(size);
+  // Freed twice, or "size" is larger than the object.
+  assert(!POOL_IS_POISONED(ptr, obj_size));
+  assert(pool->live > 0);
+  pool->live--;
+# ifndef NDEBUG
+  // Make use after free stand out.
+  memset(ptr, 0xfd, obj_size);
+# endif
+  *(void **)ptr = pool->free_list;
+  pool->free_list = ptr;
+  POOL_POISON(ptr, obj_size);
+#endif
+}
+
+#ifdef EXITFREE
+/// Give the slabs of all pools back to the system.
+static void pool_free_all_mem(void)
+{
+  for (size_t i = 0; i < POOL_CLASS_COUNT; i++) {
+    MemPool *pool = &mem_pools[i];
+    while (pool->slab_list != NULL) {
+      char *slab = pool->slab_list;
+      pool->slab_list = *(char **)slab;
+      POOL_UNPOISON(slab, POOL_SLAB_SIZE);
+      xfree(slab);
+    }
+    *pool = (MemPool){ 0 };
+  }
+}
+#endif
+
+/// Get the statistics of a size class of the small object pools.
+///
+/// @param idx  index of the size class.
+/// @param[out] obj_size  size of the objects in the class.
+/// @param[out] live  number of allocated objects.
+/// @param[out] slabs  number of slabs.
+///
+/// @return  false when "idx" is past the last size class.
+bool pool_stats(size_t idx, size_t *obj_size, size_t *live, size_t *slabs)
+  FUNC_ATTR_NONNULL_ALL
+{
+  if (idx >= POOL_CLASS_COUNT) {
+    return false;
+  }
+  *obj_size = (idx + 1) * POOL_ALIGN;
+  *live = mem_pools[idx].live;
+  *slabs = mem_pools[idx].slabs;
+  return true;
+}
+
 #if defined(EXITFREE)
 
 # include "nvim/autocmd.h"
@@ -893,6 +1053,7 @@ void free_all_mem(void)
   ui_comp_free_all_mem();
   nlua_free_all_mem();
   rpc_free_all_mem();
+  pool_free_all_mem();
 
   // should be last, in case earlier free functions deallocates arenas
   arena_free_reuse_blks();
@@ -13,3 +13,9 @@ typedef struct {
 
 // inits an empty arena.
 #define ARENA_EMPTY { .cur_blk = NULL, .pos = 0, .size = 0 }
+
+/// Memory used by a subsystem, see nvim__memstats().
+typedef struct {
+  size_t count;  ///< number of objects
+  size_t bytes;  ///< bytes allocated for them
+} MemGauge;
@@ -89,8 +89,11 @@ static int confirm_msg_used = false;            // displaying confirm_msg
 static char *confirm_msg = NULL;            // ":confirm" message
 static char *confirm_msg_tail;              // tail of confirm_msg
 
-MessageHistoryEntry *first_msg_hist = NULL;
-MessageHistoryEntry *last_msg_hist = NULL;
+/// Message history, a ring of MSG_HIST_SIZE entries.  When the history is
+/// full the oldest entry is overwritten, reusing its text buffer.
+#define MSG_HIST_SIZE (MAX_MSG_HIST_LEN + 1)
+static MessageHistoryEntry msg_hist[MSG_HIST_SIZE];
+static int msg_hist_first = 0;  ///< Index of the oldest message.
 static int msg_hist_len = 0;
 
 static FILE *verbose_fd = NULL;
@@ -329,11 +332,12 @@ bool msg_attr_keep(const char *s, int attr, bool keep, bool multiline)
 
   // Add message to history (unless it's a repeated kept message or a
   // truncated message)
+  const MessageHistoryEntry *last = msg_hist_get(-1);
   if (s != keep_msg
       || (*s != '<'
-          && last_msg_hist != NULL
-          && last_msg_hist->msg != NULL
-          && strcmp(s, last_msg_hist->msg) != 0)) {
+          && last != NULL
+          && last->msg != NULL
+          && strcmp(s, last->msg) != 0)) {
     add_msg_hist(s, -1, attr, multiline);
   }
 
@@ -979,13 +983,15 @@ static void add_msg_hist_multiattr(const char *s, int len, int attr, bool multil
     return;
   }
 
-  // Don't let the message history get too big
-  while (msg_hist_len > MAX_MSG_HIST_LEN) {
-    delete_first_msg();
+  // Don't let the message history get too big: overwrite the oldest
+  // message, keeping its text buffer.
+  if (msg_hist_len == MSG_HIST_SIZE) {
+    hl_msg_free(msg_hist[msg_hist_first].multiattr);
+    msg_hist_first = (msg_hist_first + 1) % MSG_HIST_SIZE;
+    msg_hist_len--;
   }
 
-  // allocate an entry and add the message at the end of the history
-  struct msg_hist *p = xmalloc(sizeof(struct msg_hist));
+  MessageHistoryEntry *p = &msg_hist[(msg_hist_first + msg_hist_len) % MSG_HIST_SIZE];
   if (s) {
     if (len < 0) {
       len = (int)strlen(s);
@@ -998,22 +1004,20 @@ static void add_msg_hist_multiattr(const char *s, int len, int attr, bool multil
     while (len > 0 && s[len - 1] == '\n') {
       len--;
     }
-    p->msg = xmemdupz(s, (size_t)len);
+    if (p->msg_size < (size_t)len + 1) {
+      p->msg_size = (size_t)len + 1;
+      p->msg = xrealloc(p->msg, p->msg_size);
+    }
+    memcpy(p->msg, s, (size_t)len);
+    p->msg[len] = NUL;
   } else {
-    p->msg = NULL;
+    XFREE_CLEAR(p->msg);
+    p->msg_size = 0;
   }
-  p->next = NULL;
   p->attr = attr;
   p->multiline = multiline;
   p->multiattr = multiattr;
   p->kind = msg_ext_kind;
-  if (last_msg_hist != NULL) {
-    last_msg_hist->next = p;
-  }
-  last_msg_hist = p;
-  if (first_msg_hist == NULL) {
-    first_msg_hist = last_msg_hist;
-  }
   msg_hist_len++;
 }
 
@@ -1025,19 +1029,42 @@ int delete_first_msg(void)
   if (msg_hist_len <= 0) {
     return FAIL;
   }
-  struct msg_hist *p = first_msg_hist;
-  first_msg_hist = p->next;
-  if (first_msg_hist == NULL) {  // history is becoming empty
-    assert(msg_hist_len == 1);
-    last_msg_hist = NULL;
-  }
-  xfree(p->msg);
+  MessageHistoryEntry *p = &msg_hist[msg_hist_first];
+  XFREE_CLEAR(p->msg);
+  p->msg_size = 0;
   hl_msg_free(p->multiattr);
-  xfree(p);
+  p->multiattr = (HlMessage)KV_INITIAL_VALUE;
+  msg_hist_first = (msg_hist_first + 1) % MSG_HIST_SIZE;
   msg_hist_len--;
   return OK;
 }
 
+/// @return  the number of messages in the history.
+int msg_hist_count(void)
+  FUNC_ATTR_PURE
+{
+  return msg_hist_len;
+}
+
+/// Get a message from the history.  The entry is not copied and is only
+/// valid until the next message is added to the history.
+///
+/// @param idx  Index from the oldest message, or from after the newest
+///             message when negative.
+///
+/// @return  NULL if there is no such message.
+const MessageHistoryEntry *msg_hist_get(int idx)
+  FUNC_ATTR_PURE
+{
+  if (idx < 0) {
+    idx += msg_hist_len;
+  }
+  if (idx < 0 || idx >= msg_hist_len) {
+    return NULL;
+  }
+  return &msg_hist[(msg_hist_first + idx) % MSG_HIST_SIZE];
+}
+
 /// :messages command implementation
 void ex_messages(exarg_T *eap)
   FUNC_ATTR_NONNULL_ALL
@@ -1056,19 +1083,10 @@ void ex_messages(exarg_T *eap)
     return;
   }
 
-  struct msg_hist *p = first_msg_hist;
-
+  // Skip messages when the number to show was specified.
+  int idx = 0;
   if (eap->addr_count != 0) {
-    int c = 0;
-    // Count total messages
-    for (; p != NULL && !got_int; p = p->next) {
-      c++;
-    }
-
-    c -= eap->line2;
-
-    // Skip without number of messages specified
-    for (p = first_msg_hist; p != NULL && !got_int && c > 0; p = p->next, c--) {}
+    idx = MAX(msg_hist_len - eap->line2, 0);
   }
 
   // Display what was not skipped.
@@ -1076,37 +1094,42 @@ void ex_messages(exarg_T *eap)
     if (msg_silent) {
       return;
     }
-    Array entries = ARRAY_DICT_INIT;
-    for (; p != NULL; p = p->next) {
+    // The event refers to the text in the history, only the arrays around it
+    // are allocated.
+    Arena arena = ARENA_EMPTY;
+    Array entries = arena_array(&arena, (size_t)(msg_hist_len - idx));
+    for (const MessageHistoryEntry *p; (p = msg_hist_get(idx)) != NULL; idx++) {
       if (kv_size(p->multiattr) || (p->msg && p->msg[0])) {
-        Array entry = ARRAY_DICT_INIT;
-        ADD(entry, CSTR_TO_OBJ(p->kind));
-        Array content = ARRAY_DICT_INIT;
+        Array entry = arena_array(&arena, 2);
+        ADD_C(entry, CSTR_AS_OBJ(p->kind));
+        Array content;
         if (kv_size(p->multiattr)) {
+          content = arena_array(&arena, kv_size(p->multiattr));
           for (uint32_t i = 0; i < kv_size(p->multiattr); i++) {
             HlMessageChunk chunk = kv_A(p->multiattr, i);
-            Array content_entry = ARRAY_DICT_INIT;
-            ADD(content_entry, INTEGER_OBJ(chunk.attr));
-            ADD(content_entry, STRING_OBJ(copy_string(chunk.text, NULL)));
-            ADD(content, ARRAY_OBJ(content_entry));
+            Array content_entry = arena_array(&arena, 2);
+            ADD_C(content_entry, INTEGER_OBJ(chunk.attr));
+            ADD_C(content_entry, STRING_OBJ(chunk.text));
+            ADD_C(content, ARRAY_OBJ(content_entry));
           }
-        } else if (p->msg && p->msg[0]) {
-          Array content_entry = ARRAY_DICT_INIT;
-          ADD(content_entry, INTEGER_OBJ(p->attr));
-          ADD(content_entry, CSTR_TO_OBJ(p->msg));
-          ADD(content, ARRAY_OBJ(content_entry));
+        } else {
+          content = arena_array(&arena, 1);
+          Array content_entry = arena_array(&arena, 2);
+          ADD_C(content_entry, INTEGER_OBJ(p->attr));
+          ADD_C(content_entry, CSTR_AS_OBJ(p->msg));
+          ADD_C(content, ARRAY_OBJ(content_entry));
         }
-        ADD(entry, ARRAY_OBJ(content));
-        ADD(entries, ARRAY_OBJ(entry));
+        ADD_C(entry, ARRAY_OBJ(content));
+        ADD_C(entries, ARRAY_OBJ(entry));
       }
     }
     ui_call_msg_history_show(entries);
-    api_free_array(entries);
+    arena_mem_free(arena_finish(&arena));
     msg_ext_history_visible = true;
     wait_return(false);
   } else {
     msg_hist_off = true;
-    for (; p != NULL && !got_int; p = p->next) {
+    for (const MessageHistoryEntry *p; !got_int && (p = msg_hist_get(idx)) != NULL; idx++) {
       if (kv_size(p->multiattr)) {
         msg_multiattr(p->multiattr, p->kind, false);
       } else if (p->msg != NULL) {
@@ -3178,26 +3201,33 @@ static void redir_write(const char *const str, const ptrdiff_t maxlen)
 
   if (redirecting()) {
     // If the string doesn't start with CR or NL, go to msg_col
-    if (*s != '\n' && *s != '\r') {
-      while (cur_col < msg_col) {
-        if (capture_ga) {
-          ga_concat_len(capture_ga, " ", 1);
-        }
-        if (redir_reg) {
-          write_reg_contents(redir_reg, " ", 1, true);
-        } else if (redir_vname) {
-          var_redir_str(" ", -1);
-        } else if (redir_fd != NULL) {
-          fputs(" ", redir_fd);
-        }
-        if (verbose_fd != NULL) {
-          fputs(" ", verbose_fd);
+    if (*s != '\n' && *s != '\r' && cur_col < msg_col) {
+      if (capture_ga) {
+        // Captured output only needs the padding appended, do it at once.
+        const int pad = msg_col - cur_col;
+        ga_grow(capture_ga, pad);
+        memset((char *)capture_ga->ga_data + capture_ga->ga_len, ' ', (size_t)pad);
+        capture_ga->ga_len += pad;
+      }
+      if (redir_reg || redir_vname || redir_fd != NULL || verbose_fd != NULL) {
+        while (cur_col < msg_col) {
+          if (redir_reg) {
+            write_reg_contents(redir_reg, " ", 1, true);
+          } else if (redir_vname) {
+            var_redir_str(" ", -1);
+          } else if (redir_fd != NULL) {
+            fputs(" ", redir_fd);
+          }
+          if (verbose_fd != NULL) {
+            fputs(" ", verbose_fd);
+          }
+          cur_col++;
         }
-        cur_col++;
       }
+      cur_col = msg_col;
     }
 
-    size_t len = maxlen == -1 ? strlen(s) : (size_t)maxlen;
+    size_t len = maxlen == -1 ? strlen(s) : strnlen(s, (size_t)maxlen);
     if (capture_ga) {
       ga_concat_len(capture_ga, str, len);
     }
@@ -3207,34 +3237,41 @@ static void redir_write(const char *const str, const ptrdiff_t maxlen)
     if (redir_vname) {
       var_redir_str(s, (int)maxlen);
     }
-
-    // Write and adjust the current column.
-    while (*s != NUL
-           && (maxlen < 0 || (int)(s - str) < maxlen)) {
-      if (!redir_reg && !redir_vname && !capture_ga) {
-        if (redir_fd != NULL) {
-          putc(*s, redir_fd);
-        }
-      }
-      if (verbose_fd != NULL) {
-        putc(*s, verbose_fd);
-      }
-      if (*s == '\r' || *s == '\n') {
-        cur_col = 0;
-      } else if (*s == '\t') {
-        cur_col += (8 - cur_col % 8);
-      } else {
-        cur_col++;
-      }
-      s++;
+    if (!redir_reg && !redir_vname && !capture_ga && redir_fd != NULL) {
+      fwrite(s, 1, len, redir_fd);
+    }
+    if (verbose_fd != NULL) {
+      fwrite(s, 1, len, verbose_fd);
     }
 
+    // Adjust the current column.
+    cur_col = redir_col_after(cur_col, s, len);
+
     if (msg_silent != 0) {      // should update msg_col
       msg_col = cur_col;
     }
   }
 }
 
+/// Get the column reached after writing "len" bytes of "str" starting at
+/// column "col".  Only the text after the last line break matters, thus a
+/// large captured output is not scanned character by character.
+static int redir_col_after(int col, const char *str, size_t len)
+{
+  const char *const end = str + len;
+  const char *p = end;
+  while (p > str && p[-1] != '\n' && p[-1] != '\r') {
+    p--;
+  }
+  if (p > str) {
+    col = 0;
+  }
+  for (; p < end; p++) {
+    col += *p == '\t' ? 8 - col % 8 : 1;
+  }
+  return col;
+}
+
 int redirecting(void)
 {
   return redir_fd != NULL || *p_vfile != NUL
@@ -30,11 +30,6 @@ enum {
 
 enum { MSG_HIST = 0x1000, };  ///< special attribute addition: Put message in history
 
-/// First message
-extern MessageHistoryEntry *first_msg_hist;
-/// Last message
-extern MessageHistoryEntry *last_msg_hist;
-
 EXTERN bool msg_ext_need_clear INIT( = false);
 
 /// allocated grid for messages. Used when display+=msgsep is set, or
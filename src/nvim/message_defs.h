@@ -11,10 +11,10 @@ typedef struct {
 
 typedef kvec_t(HlMessageChunk) HlMessage;
 
-/// Message history for `:messages`
-typedef struct msg_hist {
-  struct msg_hist *next;  ///< Next message.
+/// Message history entry for `:messages`
+typedef struct {
   char *msg;              ///< Message text.
+  size_t msg_size;        ///< Allocated size of "msg".
   const char *kind;       ///< Message kind (for msg_ext)
   int attr;               ///< Message highlighting.
   bool multiline;         ///< Multiline message.
@@ -25,6 +25,7 @@
 #include "nvim/main.h"
 #include "nvim/map_defs.h"
 #include "nvim/memory.h"
+#include "nvim/memory_defs.h"
 #include "nvim/message.h"
 #include "nvim/msgpack_rpc/channel.h"
 #include "nvim/msgpack_rpc/channel_defs.h"
@@ -33,6 +34,8 @@
 #include "nvim/os/input.h"
 #include "nvim/rbuffer.h"
 #include "nvim/rbuffer_defs.h"
+#include "nvim/trace.h"
+#include "nvim/trace_defs.h"
 #include "nvim/types_defs.h"
 #include "nvim/ui.h"
 #include "nvim/ui_client.h"
@@ -367,11 +370,13 @@ static void request_event(void **argv)
     goto free_ret;
   }
 
+  uint64_t trace_start = trace_begin();
   Object result = handler.fn(channel->id, e->args, &e->used_mem, &error);
   if (e->type == kMessageTypeRequest || ERROR_SET(&error)) {
     // Send the response.
     serialize_response(channel, e->handler, e->type, e->request_id, &error, &result);
   }
+  trace_end(kTraceRpcRequest, trace_start, (int64_t)channel->id, e->request_id);
   if (handler.ret_alloc) {
     api_free_object(result);
   }
@@ -498,6 +503,28 @@ void rpc_close(Channel *channel)
   }
 }
 
+/// Add the read buffers of the RPC channels to "gauge", counting the
+/// channels.
+void rpc_mem_usage(MemGauge *gauge)
+{
+  Channel *channel;
+  map_foreach_value(&channels, channel, {
+    if (!channel->is_rpc || channel->rpc.unpacker == NULL) {
+      continue;
+    }
+    gauge->count++;
+    gauge->bytes += sizeof(Unpacker) + channel->rpc.unpacker->arena.size;
+    if (channel->streamtype == kChannelStreamProc
+        || channel->streamtype == kChannelStreamSocket
+        || channel->streamtype == kChannelStreamStdio) {
+      RBuffer *buf = channel_outstream(channel)->buffer;
+      if (buf != NULL) {
+        gauge->bytes += sizeof(RBuffer) + rbuffer_capacity(buf);
+      }
+    }
+  })
+}
+
 void rpc_free(Channel *channel)
 {
   remote_ui_disconnect(channel->id);
@@ -6412,6 +6412,7 @@ static void nv_put(cmdarg_T *cap)
 static void nv_put_opt(cmdarg_T *cap, bool fix_indent)
 {
   yankreg_T *savereg = NULL;
+  bool savereg_shared = false;
   bool empty = false;
   bool was_visual = false;
   int dir;
@@ -6464,7 +6465,7 @@ static void nv_put_opt(cmdarg_T *cap, bool fix_indent)
     if (regname == 0 || regname == '"' || clipoverwrite
         || ascii_isdigit(regname) || regname == '-') {
       // The delete might overwrite the register we want to put, save it first
-      savereg = copy_register(regname);
+      savereg = copy_register(regname, &savereg_shared);
     }
 
     // Temporarily disable folding, as deleting a fold marker may cause
@@ -6517,7 +6518,9 @@ static void nv_put_opt(cmdarg_T *cap, bool fix_indent)
 
   // If a register was saved, free it
   if (savereg != NULL) {
-    free_register(savereg);
+    if (!savereg_shared) {
+      free_register(savereg);
+    }
     xfree(savereg);
   }
 
@@ -637,6 +637,12 @@ void op_reindent(oparg_T *oap, Indenter how)
   if (u_savecommon(curbuf, start_lnum - 1, start_lnum + oap->line_count,
                    start_lnum + oap->line_count, false) == OK) {
     int amount;
+    // C-indenting searches back for the enclosing '{' from every line.
+    // Going down, the lines above don't change, thus remember what the
+    // searches found to avoid scanning the same lines again and again.
+    if (how == get_c_indent) {
+      findmatch_memo_start(curbuf);
+    }
     for (i = oap->line_count - 1; i >= 0 && !got_int; i--) {
       // it's a slow thing to do, so give feedback so there's no worry
       // that the computer's just hung.
@@ -663,11 +669,13 @@ void op_reindent(oparg_T *oap, Indenter how)
             first_changed = curwin->w_cursor.lnum;
           }
           last_changed = curwin->w_cursor.lnum;
+          findmatch_memo_changed(curwin->w_cursor.lnum);
         }
       }
       curwin->w_cursor.lnum++;
       curwin->w_cursor.col = 0;      // make sure it's valid
     }
+    findmatch_memo_stop();
   }
 
   // put cursor on first non-blank of indented line
@@ -840,16 +848,35 @@ static bool is_append_register(int regname)
   return ASCII_ISUPPER(regname);
 }
 
+/// @param[out] shared  Set to true when the returned register shares its lines
+///                     with the original register, then only the returned
+///                     struct itself must be freed.
+///
 /// @return  a copy of contents in register `name` for use in do_put. Should be
 ///          freed by caller.
-yankreg_T *copy_register(int name)
-  FUNC_ATTR_NONNULL_RET
+yankreg_T *copy_register(int name, bool *shared)
+  FUNC_ATTR_NONNULL_RET FUNC_ATTR_NONNULL_ARG(2)
 {
   yankreg_T *reg = get_yank_register(name, YREG_PASTE);
 
   yankreg_T *copy = xmalloc(sizeof(yankreg_T));
   *copy = *reg;
-  if (copy->y_size == 0) {
+  // A delete only frees register "9 (and "-), registers "0 to "8 are shifted
+  // but keep their lines.  Unless a callback that may change registers can
+  // run during the put, the lines can be shared instead of copying a possibly
+  // huge register.  Callbacks are buffer update (on_lines/on_bytes)
+  // callbacks, autocommands and the clipboard provider.
+  *shared = reg >= &y_regs[0] && reg <= &y_regs[8]
+            && !buf_updates_active(curbuf)
+            && !(cb_flags & CB_UNNAMEDMASK)
+            && !has_event(EVENT_TEXTYANKPOST)
+            && !has_event(EVENT_TEXTCHANGED)
+            && !has_event(EVENT_TEXTCHANGEDI)
+            && !has_event(EVENT_TEXTCHANGEDP)
+            && !has_event(EVENT_TEXTCHANGEDT);
+  if (*shared) {
+    copy->additional_data = NULL;
+  } else if (copy->y_size == 0) {
     copy->y_array = NULL;
   } else {
     copy->y_array = xcalloc(copy->y_size, sizeof(char *));
@@ -2628,7 +2655,7 @@ static void op_yank_reg(oparg_T *oap, bool message, yankreg_T *reg, bool append)
       break;
 
     case kMTLineWise:
-      reg->y_array[y_idx] = xstrdup(ml_get(lnum));
+      reg->y_array[y_idx] = xmemdupz(ml_get(lnum), (size_t)ml_get_len(lnum));
       break;
 
     case kMTCharWise:
@@ -2643,13 +2670,8 @@ static void op_yank_reg(oparg_T *oap, bool message, yankreg_T *reg, bool append)
   }
 
   if (curr != reg) {      // append the new block to the old block
-    size_t j;
-    char **new_ptr = xmalloc(sizeof(char *) * (curr->y_size + reg->y_size));
-    for (j = 0; j < curr->y_size; j++) {
-      new_ptr[j] = curr->y_array[j];
-    }
-    xfree(curr->y_array);
-    curr->y_array = new_ptr;
+    size_t j = curr->y_size;
+    curr->y_array = xrealloc(curr->y_array, sizeof(char *) * (curr->y_size + reg->y_size));
 
     if (yank_type == kMTLineWise) {
       // kMTLineWise overrides kMTCharWise and kMTBlockWise
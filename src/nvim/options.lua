@@ -7206,6 +7206,8 @@ return {
       desc = [=[
         When on, use temp files for shell commands.  When off use a pipe.
         When using a pipe is not possible temp files are used anyway.
+        With a pipe, lines are streamed to the command and its output is
+        inserted as it arrives, which is faster for large ranges.
         The advantage of using a pipe is that nobody can read the temp file
         and the 'shell' command does not need to support redirection.
         The advantage of using a temp file is that the file type and encoding
@@ -31,6 +31,7 @@
 #include "nvim/memory.h"
 #include "nvim/message.h"
 #include "nvim/option_vars.h"
+#include "nvim/os/env.h"
 #include "nvim/os/fs.h"
 #include "nvim/os/os_defs.h"
 #include "nvim/os/shell.h"
@@ -54,11 +55,25 @@
 
 #define SHELL_SPECIAL "\t \"&'$;<>()\\|"
 
+#define FILTER_CHUNK_SIZE   1024 * 64U      // Bytes of buffer lines written per chunk.
+
 typedef struct {
   char *data;
   size_t cap, len;
 } DynamicBuffer;
 
+/// State of a filter command that streams lines of the current buffer to its
+/// stdin and/or appends its output to the buffer as it arrives, instead of
+/// collecting everything in memory first.
+typedef struct {
+  bool write;         ///< send lines b_op_start..b_op_end to stdin
+  bool read;          ///< insert output into the buffer
+  linenr_T in_lnum;   ///< next line to send to stdin
+  linenr_T in_last;   ///< last line to send to stdin
+  linenr_T in_count;  ///< buffer line count before output was inserted
+  DynamicBuffer out;  ///< output not yet inserted (incomplete line)
+} ShellFilter;
+
 #ifdef INCLUDE_GENERATED_DECLARATIONS
 # include "os/shell.c.generated.h"
 #endif
@@ -605,6 +620,95 @@ char **shell_build_argv(const char *cmd, const char *extra_args)
   return rv;
 }
 
+/// Builds the argument vector for running `cmd` directly, without starting
+/// 'shell', if that is known to give the same result. This is the case when
+/// 'shell' is a plain POSIX shell, 'shellcmdflag' has its default "-c" (so no
+/// rc file or alias is involved), no quoting options are set, and `cmd` is a
+/// single simple command: only words made of characters the shell does not
+/// interpret, the first of which is an executable that is not a shell builtin.
+/// If the executable cannot be started (e.g. a script without "#!"), the
+/// caller runs `cmd` with 'shell' after all.
+///
+/// Saves a fork+exec of the shell for each system() call of plugins that run
+/// many short commands (e.g. "git rev-parse --show-toplevel").
+///
+/// @param cmd Command string.
+/// @return Newly allocated argument vector with argv[0] resolved to a full
+///         path, or NULL if `cmd` must be run by 'shell'.
+char **shell_build_argv_direct(const char *cmd)
+  FUNC_ATTR_NONNULL_ALL
+{
+#ifdef MSWIN
+  return NULL;
+#else
+  static const char *const shells[] = { "sh", "dash", "bash", "ksh", "mksh" };
+  // Words the shell never looks up in $PATH: keywords, POSIX special and
+  // regular builtins, and the builtins of bash and ksh.  An executable of the
+  // same name may exist but can behave differently (e.g. "echo" escapes,
+  // "kill %1", "pwd" with symlinks) or be meaningless outside the shell.
+  static const char *const builtins[] = {
+    "alias", "bg", "bind", "break", "builtin", "caller", "case", "cd",
+    "command", "continue", "declare", "dirs", "disown", "do", "done", "echo",
+    "elif", "else", "enable", "esac", "eval", "exec", "exit", "export",
+    "false", "fc", "fg", "fi", "for", "function", "getopts", "hash", "help",
+    "history", "if", "in", "jobs", "kill", "let", "local", "logout",
+    "mapfile", "newgrp", "popd", "print", "printf", "pushd", "pwd", "read",
+    "readarray", "readonly", "return", "select", "set", "shift", "shopt",
+    "source", "suspend", "test", "then", "time", "times", "trap", "true",
+    "type", "typeset", "ulimit", "umask", "unalias", "unset", "until", "wait",
+    "whence", "while",
+  };
+
+  if (*p_sxq != NUL || *p_shq != NUL || strcmp(p_shcf, "-c") != 0
+      || tokenize(p_sh, NULL) != 1) {
+    return NULL;
+  }
+  const char *shell = path_tail(p_sh);
+  bool known_shell = false;
+  for (size_t i = 0; i < ARRAY_SIZE(shells); i++) {
+    known_shell |= strcmp(shell, shells[i]) == 0;
+  }
+  // Non-interactive bash sources $BASH_ENV, which may change $PATH.
+  if (!known_shell || (strcmp(shell, "bash") == 0 && os_env_exists("BASH_ENV"))) {
+    return NULL;
+  }
+
+  const char *p = skipwhite(cmd);
+  if (*p == NUL) {
+    return NULL;
+  }
+  bool first_word = true;
+  for (; *p != NUL; p++) {
+    if (ascii_iswhite(*p)) {
+      first_word = false;
+    } else if (!ASCII_ISALNUM(*p) && vim_strchr("-_./,:@%+", (uint8_t)(*p)) == NULL
+               && (first_word || *p != '=')) {
+      return NULL;
+    }
+  }
+
+  size_t argc = tokenize(skipwhite(cmd), NULL);
+  char **rv = xmalloc((argc + 1) * sizeof(*rv));
+  tokenize(skipwhite(cmd), rv);
+  rv[argc] = NULL;
+
+  for (size_t i = 0; i < ARRAY_SIZE(builtins); i++) {
+    if (strcmp(rv[0], builtins[i]) == 0) {
+      shell_free_argv(rv);
+      return NULL;
+    }
+  }
+  char *exe_resolved = NULL;
+  if (!os_can_exe(rv[0], &exe_resolved, true)) {
+    shell_free_argv(rv);
+    return NULL;
+  }
+  xfree(rv[0]);
+  rv[0] = exe_resolved;
+  return rv;
+#endif
+}
+
 /// Releases the memory allocated by `shell_build_argv`.
 ///
 /// @param argv The argument vector.
@@ -668,9 +772,7 @@ char *shell_argv_to_str(char **const argv)
 /// @return shell command exit code
 int os_call_shell(char *cmd, ShellOpts opts, char *extra_args)
 {
-  DynamicBuffer input = DYNAMIC_BUFFER_INIT;
-  char *output = NULL;
-  char **output_ptr = NULL;
+  ShellFilter filter = { .out = DYNAMIC_BUFFER_INIT };
   int current_state = State;
   bool forward_output = true;
 
@@ -683,11 +785,14 @@ int os_call_shell(char *cmd, ShellOpts opts, char *extra_args)
     State = MODE_EXTERNCMD;
 
     if (opts & kShellOptWrite) {
-      read_input(&input);
+      filter.write = true;
+      filter.in_lnum = curbuf->b_op_start.lnum;
+      filter.in_last = curbuf->b_op_end.lnum;
+      filter.in_count = curbuf->b_ml.ml_line_count;
     }
 
     if (opts & kShellOptRead) {
-      output_ptr = &output;
+      filter.read = true;
       forward_output = false;
     } else if (opts & kShellOptDoOut) {
       // Caller has already redirected output
@@ -695,16 +800,25 @@ int os_call_shell(char *cmd, ShellOpts opts, char *extra_args)
     }
   }
 
-  size_t nread;
-  int exitcode = do_os_system(shell_build_argv(cmd, extra_args),
-                              input.data, input.len, output_ptr, &nread,
-                              emsg_silent, forward_output);
-  xfree(input.data);
+  char **argv = NULL;
+  if (cmd != NULL && extra_args == NULL && !(opts & kShellOptExpand)) {
+    argv = shell_build_argv_direct(cmd);
+  }
+  const char *direct_cmd = argv != NULL ? cmd : NULL;
+  if (argv == NULL) {
+    argv = shell_build_argv(cmd, extra_args);
+  }
+
+  int exitcode = do_os_system(argv, NULL, 0, NULL, NULL,
+                              emsg_silent, forward_output, direct_cmd,
+                              (filter.write || filter.read) ? &filter : NULL);
 
-  if (output) {
-    write_output(output, nread, true);
-    xfree(output);
+  if (filter.read && filter.out.data) {
+    // Insert the last line, which may not end in a NL.
+    filter.out.data[filter.out.len] = NUL;
+    write_output(filter.out.data, filter.out.len, true);
   }
+  xfree(filter.out.data);
 
   if (!emsg_silent && exitcode != 0 && !(opts & kShellOptSilent)) {
     msg_puts(_("\nshell returned "));
@@ -834,7 +948,7 @@ done:
 ///   char *output = NULL;
 ///   size_t nread = 0;
 ///   char *argv[] = {"ls", "-la", NULL};
-///   int exitcode = os_system(argv, NULL, 0, &output, &nread);
+///   int exitcode = os_system(argv, NULL, 0, &output, &nread, NULL);
 ///
 /// @param argv The commandline arguments to be passed to the shell. `argv`
 ///             will be consumed.
@@ -847,30 +961,45 @@ done:
 ///                    the shell output will be ignored.
 /// @param[out] nread the number of bytes in the returned buffer (if the
 ///             returned buffer is not NULL)
+/// @param direct_cmd When not NULL, `argv` is from shell_build_argv_direct()
+///                   for this command.
 /// @return the return code of the process, -1 if the process couldn't be
 ///         started properly
 int os_system(char **argv, const char *input, size_t len, char **output,
-              size_t *nread) FUNC_ATTR_NONNULL_ARG(1)
+              size_t *nread, const char *direct_cmd) FUNC_ATTR_NONNULL_ARG(1)
 {
-  return do_os_system(argv, input, len, output, nread, true, false);
+  return do_os_system(argv, input, len, output, nread, true, false, direct_cmd, NULL);
 }
 
+/// @param direct_cmd  When not NULL, `argv` is from shell_build_argv_direct()
+///                    for this command, counted in g_stats.spawn_direct once
+///                    the process has started.  If it cannot be started (e.g.
+///                    a script without "#!" gives ENOEXEC) the command is run
+///                    by 'shell' instead.
+/// @param filter  When not NULL, stream lines of the current buffer to stdin
+///                and/or insert output into the buffer as it arrives.
+///                "input" and "output" are ignored then.
 static int do_os_system(char **argv, const char *input, size_t len, char **output, size_t *nread,
-                        bool silent, bool forward_output)
+                        bool silent, bool forward_output, const char *direct_cmd,
+                        ShellFilter *filter)
 {
   out_data_decide_throttle(0);  // Initialize throttle decider.
   out_data_ring(NULL, 0);       // Initialize output ring-buffer.
-  bool has_input = (input != NULL && input[0] != '\0');
+  bool has_input = filter ? filter->write : (input != NULL && input[0] != '\0');
 
   // the output buffer
   DynamicBuffer buf = DYNAMIC_BUFFER_INIT;
   stream_read_cb data_cb = system_data_cb;
+  void *data_cb_data = &buf;
   if (nread) {
     *nread = 0;
   }
 
   if (forward_output) {
     data_cb = out_data_cb;
+  } else if (filter && filter->read) {
+    data_cb = filter_data_cb;
+    data_cb_data = filter;
   } else if (!output) {
     data_cb = NULL;
   }
@@ -887,6 +1016,12 @@ static int do_os_system(char **argv, const char *input, size_t len, char **outpu
   int status = process_spawn(proc, has_input, true, true);
   if (status) {
     loop_poll_events(&main_loop, 0);
+    if (direct_cmd != NULL) {
+      // Let 'shell' run it, like it did before.
+      multiqueue_free(events);
+      return do_os_system(shell_build_argv(direct_cmd, NULL), input, len, output, nread,
+                          silent, forward_output, NULL, filter);
+    }
     // Failed, probably 'shell' is not executable.
     if (!silent) {
       msg_puts(_("\nshell failed to start: "));
@@ -898,6 +1033,9 @@ static int do_os_system(char **argv, const char *input, size_t len, char **outpu
     multiqueue_free(events);
     return -1;
   }
+  if (direct_cmd != NULL) {
+    g_stats.spawn_direct++;
+  }
 
   // Note: unlike process events, stream events are not queued, as we want to
   // deal with stream events as fast a possible.  It prevents closing the
@@ -907,12 +1045,19 @@ static int do_os_system(char **argv, const char *input, size_t len, char **outpu
     wstream_init(&proc->in, 0);
   }
   rstream_init(&proc->out, 0);
-  rstream_start(&proc->out, data_cb, &buf);
+  rstream_start(&proc->out, data_cb, data_cb_data);
   rstream_init(&proc->err, 0);
-  rstream_start(&proc->err, data_cb, &buf);
+  rstream_start(&proc->err, data_cb, data_cb_data);
 
   // write the input, if any
-  if (has_input) {
+  if (filter && filter->write) {
+    // Lines are written in chunks, the next one when the previous is done.
+    wstream_set_write_cb(&proc->in, filter_write_cb, filter);
+    if (!filter_write_chunk(&proc->in, filter)) {
+      process_stop(proc);
+      return -1;
+    }
+  } else if (has_input) {
     WBuffer *input_buffer = wstream_new_buffer((char *)input, len, 1, NULL);
 
     if (!wstream_write(&proc->in, input_buffer)) {
@@ -1228,54 +1373,86 @@ static size_t word_length(const char *str)
   return length;
 }
 
-/// To remain compatible with the old implementation (which forked a process
-/// for writing) the entire text is copied to a temporary buffer before the
-/// event loop starts. If we don't (by writing in chunks returned by `ml_get`)
-/// the buffer being modified might get modified by reading from the process
-/// before we finish writing.
-static void read_input(DynamicBuffer *buf)
+/// Appends buffer line "lnum" to "buf" as it is written to a file: NL is
+/// translated to NUL and a NL is added unless the line should not have one.
+/// The output of the filter may already be inserted below the range, so the
+/// range end and the line count are taken from "filter", as they were when
+/// the filter was started.
+static void read_input_line(DynamicBuffer *buf, const ShellFilter *filter, linenr_T lnum)
 {
-  size_t written = 0;
-  size_t len = 0;
-  linenr_T lnum = curbuf->b_op_start.lnum;
   char *lp = ml_get(lnum);
+  size_t len = (size_t)ml_get_len(lnum);
+  dynamic_buffer_ensure(buf, buf->len + len + 1);
+  char *dst = buf->data + buf->len;
+  for (size_t i = 0; i < len; i++) {
+    // NL -> NUL translation
+    dst[i] = lp[i] == NL ? NUL : lp[i];
+  }
+  buf->len += len;
 
-  while (true) {
-    size_t l = strlen(lp + written);
-    if (l == 0) {
-      len = 0;
-    } else if (lp[written] == NL) {
-      // NL -> NUL translation
-      len = 1;
-      dynamic_buffer_ensure(buf, buf->len + len);
-      buf->data[buf->len++] = NUL;
-    } else {
-      char *s = vim_strchr(lp + written, NL);
-      len = s == NULL ? l : (size_t)(s - (lp + written));
-      dynamic_buffer_ensure(buf, buf->len + len);
-      memcpy(buf->data + buf->len, lp + written, len);
-      buf->len += len;
-    }
+  if (lnum != filter->in_last
+      || (!curbuf->b_p_bin && curbuf->b_p_fixeol)
+      || (lnum != curbuf->b_no_eol_lnum
+          && (lnum != filter->in_count || curbuf->b_p_eol))) {
+    buf->data[buf->len++] = NL;
+  }
+}
 
-    if (len == l) {
-      // Finished a line, add a NL, unless this line should not have one.
-      if (lnum != curbuf->b_op_end.lnum
-          || (!curbuf->b_p_bin && curbuf->b_p_fixeol)
-          || (lnum != curbuf->b_no_eol_lnum
-              && (lnum != curbuf->b_ml.ml_line_count || curbuf->b_p_eol))) {
-        dynamic_buffer_ensure(buf, buf->len + 1);
-        buf->data[buf->len++] = NL;
-      }
-      lnum++;
-      if (lnum > curbuf->b_op_end.lnum) {
-        break;
-      }
-      lp = ml_get(lnum);
-      written = 0;
-    } else if (len > 0) {
-      written += len;
-    }
+/// Writes the next chunk of buffer lines to the stdin of a filter command.
+/// Lines are copied when the chunk is created: the buffer is modified by
+/// inserting the output, but only below the lines being written.
+///
+/// @return false if the write failed
+static bool filter_write_chunk(Stream *in, ShellFilter *filter)
+{
+  DynamicBuffer chunk = DYNAMIC_BUFFER_INIT;
+  while (filter->in_lnum <= filter->in_last && chunk.len < FILTER_CHUNK_SIZE) {
+    read_input_line(&chunk, filter, filter->in_lnum++);
+  }
+  if (chunk.len == 0) {
+    xfree(chunk.data);
+    return true;
+  }
+  return wstream_write(in, wstream_new_buffer(chunk.data, chunk.len, 1, xfree));
+}
+
+static void filter_write_cb(Stream *stream, void *data, int status)
+{
+  ShellFilter *filter = data;
+  if (status) {
+    shell_write_cb(stream, NULL, status);
+    return;
+  }
+  if (stream->closed) {
+    return;
+  }
+  if (filter->in_lnum > filter->in_last) {
+    // close the input stream after everything is written
+    stream_close(stream, NULL, NULL);
+  } else if (!filter_write_chunk(stream, filter)) {
+    stream_close(stream, NULL, NULL);
+  }
+}
+
+/// Inserts complete lines of filter output into the buffer as they arrive.
+static void filter_data_cb(Stream *stream, RBuffer *buf, size_t count, void *data, bool eof)
+{
+  ShellFilter *filter = data;
+  DynamicBuffer *out = &filter->out;
+
+  size_t nread = buf->size;
+  dynamic_buffer_ensure(out, out->len + nread + 1);
+  rbuffer_read(buf, out->data + out->len, nread);
+  out->len += nread;
+
+  // Only pass complete lines, write_output() translates NUL in what it scans.
+  char *last_nl = xmemrchr(out->data, NL, out->len);
+  if (last_nl == NULL) {
+    return;
   }
+  size_t written = write_output(out->data, (size_t)(last_nl - out->data) + 1, false);
+  out->len -= written;
+  memmove(out->data, out->data + written, out->len);
 }
 
 static size_t write_output(char *output, size_t remaining, bool eof)
@@ -19,7 +19,8 @@
 
 #define HAVE_ACL (HAVE_POSIX_ACL || HAVE_SOLARIS_ACL)
 
-// Special wildcards that need to be handled by the shell.
+// Special wildcards that need to be handled by the shell.  Braces and single
+// quotes are expanded by gen_expand_wildcards() itself, like the shell would.
 #define SPECIAL_WILDCHAR "`'{"
 
 // Character that separates entries in $PATH.
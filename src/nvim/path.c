@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <inttypes.h>
 #include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -1190,6 +1191,194 @@ static bool has_special_wildchar(char *p, int flags)
   }
   return false;
 }
+
+/// Finds the "}" matching the "{" at "p", ignoring escaped characters.
+///
+/// @param[out] has_comma  whether there is a "," at the level of "p".
+///
+/// @return  pointer to the "}", or NULL if there is none.
+static const char *find_brace_end(const char *p, bool *has_comma)
+{
+  int depth = 0;
+  *has_comma = false;
+  for (; *p != NUL; p++) {
+    if (*p == '\\' && p[1] != NUL) {
+      p++;
+    } else if (*p == '{') {
+      depth++;
+    } else if (*p == '}') {
+      if (--depth == 0) {
+        return p;
+      }
+    } else if (*p == ',' && depth == 1) {
+      *has_comma = true;
+    }
+  }
+  return NULL;
+}
+
+/// Parses a "{m..n}" integer sequence between "p" and "end".
+static bool parse_brace_seq(const char *p, const char *end, int64_t *from, int64_t *to)
+{
+  char *q;
+  *from = strtoll(p, &q, 10);
+  if (q == p || q + 2 >= end || q[0] != '.' || q[1] != '.') {
+    return false;
+  }
+  p = q + 2;
+  *to = strtoll(p, &q, 10);
+  return q != p && q == end;
+}
+
+/// Performs shell-like brace expansion on "pat": "a{b,c}d" becomes "abd" and
+/// "acd", "{1..3}" becomes "1", "2" and "3". Braces without a "," are kept.
+/// Words are appended to "gap" regardless of whether such files exist.
+static void expand_braces(const char *pat, garray_T *gap)
+{
+  for (const char *p = pat; *p != NUL; p++) {
+    if (*p == '\\' && p[1] != NUL) {
+      p++;
+      continue;
+    }
+    if (*p == '\'' && vim_strchr(p + 1, '\'') != NULL) {
+      // No expansion inside quotes.
+      p = vim_strchr(p + 1, '\'');
+      continue;
+    }
+    if (*p != '{') {
+      continue;
+    }
+    bool has_comma;
+    const char *end = find_brace_end(p, &has_comma);
+    if (end == NULL) {
+      break;
+    }
+    size_t prefix_len = (size_t)(p - pat);
+    const char *suffix = end + 1;
+    int64_t from, to;
+    if (has_comma) {
+      // Split at the commas on the level of this brace.
+      const char *alt = p + 1;
+      int depth = 0;
+      for (const char *q = alt;; q++) {
+        if (*q == '\\' && q[1] != NUL) {
+          q++;
+          continue;
+        }
+        if (*q == '{') {
+          depth++;
+        } else if (*q == '}' && depth > 0) {
+          depth--;
+        } else if ((*q == ',' && depth == 0) || q == end) {
+          size_t alt_len = (size_t)(q - alt);
+          char *word = xmalloc(prefix_len + alt_len + strlen(suffix) + 1);
+          memcpy(word, pat, prefix_len);
+          memcpy(word + prefix_len, alt, alt_len);
+          STRCPY(word + prefix_len + alt_len, suffix);
+          expand_braces(word, gap);
+          xfree(word);
+          alt = q + 1;
+          if (q == end) {
+            break;
+          }
+        }
+      }
+      return;
+    } else if (parse_brace_seq(p + 1, end, &from, &to)) {
+      int64_t step = from <= to ? 1 : -1;
+      for (int64_t i = from;; i += step) {
+        char num[NUMBUFLEN];
+        snprintf(num, sizeof(num), "%" PRId64, i);
+        size_t len = prefix_len + strlen(num) + strlen(suffix) + 1;
+        char *word = xmalloc(len);
+        snprintf(word, len, "%.*s%s%s", (int)prefix_len, pat, num, suffix);
+        expand_braces(word, gap);
+        xfree(word);
+        if (i == to) {
+          break;
+        }
+      }
+      return;
+    }
+    // Not expandable, look for braces inside it.
+  }
+  GA_APPEND(char *, gap, xstrdup(pat));
+}
+
+/// Turns a word that went through brace expansion into a file pattern, like
+/// the shell would: single quotes are removed and the quoted characters that
+/// are special in file patterns are escaped.  Braces that are left are taken
+/// literally.
+///
+/// @return  allocated string.
+static char *shell_word_to_pat(const char *word)
+{
+  garray_T ga;
+  ga_init(&ga, 1, (int)strlen(word) * 2 + 1);
+  bool in_quote = false;
+  for (const char *p = word; *p != NUL; p++) {
+    if (!in_quote && *p == '\\' && p[1] != NUL) {
+      ga_append(&ga, (uint8_t)(*p++));
+      ga_append(&ga, (uint8_t)(*p));
+    } else if (*p == '\'' && (in_quote || vim_strchr(p + 1, '\'') != NULL)) {
+      in_quote = !in_quote;
+    } else {
+      if (in_quote ? vim_strchr("*?[]{}\\$`~' ", (uint8_t)(*p)) != NULL
+                   : (*p == '{' || *p == '}')) {
+        ga_append(&ga, '\\');
+      }
+      ga_append(&ga, (uint8_t)(*p));
+    }
+  }
+  ga_append(&ga, NUL);
+  return ga.ga_data;
+}
+
+/// Applies the shell syntax that can be handled without starting a shell to
+/// patterns: brace expansion and removal of single quotes. Backtick
+/// expressions are left alone.
+///
+/// @return  true when patterns changed. Then "*num_new" and "*new_pat" are set
+///          to an allocated array, to be freed with FreeWild().
+static bool expand_pat_shell_syntax(int num_pat, char **pat, int *num_new, char ***new_pat)
+{
+  bool found = false;
+  for (int i = 0; i < num_pat && !found; i++) {
+    found = !vim_backtick(pat[i])
+            && (vim_strchr(pat[i], '{') != NULL || vim_strchr(pat[i], '\'') != NULL);
+  }
+  if (!found) {
+    return false;
+  }
+
+  garray_T ga;
+  ga_init(&ga, (int)sizeof(char *), num_pat);
+  for (int i = 0; i < num_pat; i++) {
+    if (vim_backtick(pat[i])) {
+      GA_APPEND(char *, &ga, xstrdup(pat[i]));
+      continue;
+    }
+    int start = ga.ga_len;
+    expand_braces(pat[i], &ga);
+    for (int j = start; j < ga.ga_len; j++) {
+      char *word = ((char **)ga.ga_data)[j];
+      ((char **)ga.ga_data)[j] = shell_word_to_pat(word);
+      xfree(word);
+    }
+  }
+
+  bool changed = ga.ga_len != num_pat;
+  for (int i = 0; i < num_pat && !changed; i++) {
+    changed = strcmp(pat[i], ((char **)ga.ga_data)[i]) != 0;
+  }
+  if (!changed) {
+    ga_clear_strings(&ga);
+    return false;
+  }
+  *num_new = ga.ga_len;
+  *new_pat = ga.ga_data;
+  return true;
+}
 #endif
 
 /// Generic wildcard expansion code.
@@ -1238,6 +1427,16 @@ int gen_expand_wildcards(int num_pat, char **pat, int *num_file, char ***file, i
   for (int i = 0; i < num_pat; i++) {
     if (has_special_wildchar(pat[i], flags)
         && !(vim_backtick(pat[i]) && pat[i][1] == '=')) {
+      // Do the brace expansion and quote removal of the shell here, then
+      // expand the resulting words.  The shell is still needed for
+      // backticks.
+      int num_expanded;
+      char **expanded;
+      if (expand_pat_shell_syntax(num_pat, pat, &num_expanded, &expanded)) {
+        int ret = gen_expand_wildcards(num_expanded, expanded, num_file, file, flags);
+        FreeWild(num_expanded, expanded);
+        return ret;
+      }
       return os_expand_wildcards(num_pat, pat, num_file, file, flags);
     }
   }
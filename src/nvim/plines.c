@@ -5,6 +5,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "klib/kvec.h"
 #include "nvim/ascii_defs.h"
 #include "nvim/buffer.h"
 #include "nvim/buffer_defs.h"
@@ -21,6 +22,7 @@
 #include "nvim/mbyte.h"
 #include "nvim/mbyte_defs.h"
 #include "nvim/memline.h"
+#include "nvim/memory.h"
 #include "nvim/move.h"
 #include "nvim/option.h"
 #include "nvim/option_vars.h"
@@ -34,6 +36,22 @@
 # include "plines.c.generated.h"
 #endif
 
+/// Number of entries in the per-window cache of line heights.  Must be a
+/// power of two.
+#define PLINES_CACHE_SIZE 256
+
+/// Minimal length of a line for its height to be cached: shorter lines are
+/// measured quickly enough.
+#define PLINES_CACHE_MINLEN 128
+
+/// Number of bytes between virtual column checkpoints in a long line.  Lines
+/// shorter than this don't get checkpoints.
+#define VCOL_CHECKPOINT_STEP 4096
+
+/// Incremented when an option or setting changes how lines are wrapped,
+/// which invalidates all cached line heights and virtual columns.
+static unsigned plines_cache_gen = 0;
+
 /// Functions calculating horizontal size of text, when displayed in a window.
 
 /// Return the number of cells the first char in "p" will take on the screen,
@@ -463,12 +481,20 @@ int linesize_fast(CharsizeArg const *const csarg, int vcol_arg, colnr_T const le
   bool const use_tabstop = csarg->use_tabstop;
 
   char *const line = csarg->line;
+  char *const end = line + strnlen(line, (size_t)MAX(len, 0));
   int64_t vcol = vcol_arg;
 
   StrCharInfo ci = utf_ptr2StrCharInfo(line);
-  while (ci.ptr - line < len && *ci.ptr != NUL) {
-    vcol += charsize_fast_impl(wp, use_tabstop, vcol_arg, ci.chr.value).width;
-    ci = utfc_next(ci);
+  while (ci.ptr < end) {
+    // A run of printable ASCII takes one cell per byte.
+    size_t n = ascii_printable_len(ci.ptr, (size_t)(end - ci.ptr));
+    if (n > 1) {
+      vcol += (int64_t)n;
+      ci = utf_ptr2StrCharInfo(ci.ptr + n);
+    } else {
+      vcol += charsize_fast_impl(wp, use_tabstop, vcol_arg, ci.chr.value).width;
+      ci = utfc_next(ci);
+    }
     if (vcol > MAXCOL) {
       vcol_arg = MAXCOL;
       break;
@@ -497,6 +523,133 @@ static int virt_text_cursor_off(const CharsizeArg *csarg, bool on_NUL)
   return off;
 }
 
+/// Get the checkpoints of virtual columns for line "lnum" in "wp", clearing
+/// them when they are for another line, buffer or options.
+///
+/// @return  NULL when line "lnum" is too short to need checkpoints.
+static vcol_cache_T *vcol_cache_get(win_T *wp, linenr_T lnum)
+{
+  if (ml_get_buf_len(wp->w_buffer, lnum) < 2 * VCOL_CHECKPOINT_STEP) {
+    return NULL;
+  }
+
+  vcol_cache_T *const vc = &wp->w_vcol_cache;
+  if (!vcol_cache_valid(wp, lnum)) {
+    kv_size(vc->vc_points) = 0;
+    vc->vc_lnum = lnum;
+    vc->vc_buf = wp->w_buffer->handle;
+    vc->vc_changedtick = buf_get_changedtick(wp->w_buffer);
+    vc->vc_gen = plines_cache_gen;
+  }
+  return vc;
+}
+
+/// Check if the checkpoints of virtual columns of "wp" are for line "lnum" of
+/// its buffer as it is now.  The buffer may have been changed while another
+/// one was shown in "wp".
+static bool vcol_cache_valid(win_T *wp, linenr_T lnum)
+{
+  vcol_cache_T *const vc = &wp->w_vcol_cache;
+  return vc->vc_lnum == lnum && vc->vc_buf == wp->w_buffer->handle
+         && vc->vc_changedtick == buf_get_changedtick(wp->w_buffer)
+         && vc->vc_gen == plines_cache_gen;
+}
+
+/// Find the last checkpoint in "vc" before byte "col" and virtual column
+/// "vcol", so that counting virtual columns can start there instead of at
+/// the start of the line.
+///
+/// @param[out] cp_col   byte index of the checkpoint
+/// @param[out] cp_vcol  virtual column of the checkpoint
+///
+/// @return  false when there is no such checkpoint.
+static bool vcol_cache_find(vcol_cache_T *vc, colnr_T col, colnr_T vcol, colnr_T *cp_col,
+                            colnr_T *cp_vcol)
+{
+  // Both the byte index and the virtual column increase with every point.
+  size_t lo = 0;
+  size_t hi = kv_size(vc->vc_points);
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    vcol_point_T *const vp = &kv_A(vc->vc_points, mid);
+    if (vp->vp_col <= col && vp->vp_vcol < vcol) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  if (lo == 0) {
+    return false;
+  }
+  *cp_col = kv_A(vc->vc_points, lo - 1).vp_col;
+  *cp_vcol = kv_A(vc->vc_points, lo - 1).vp_vcol;
+  return true;
+}
+
+/// Byte index from which the next checkpoint is to be added to "vc".
+static colnr_T vcol_cache_next(vcol_cache_T *vc)
+{
+  return vc == NULL ? MAXCOL : (colnr_T)(kv_size(vc->vc_points) + 1) * VCOL_CHECKPOINT_STEP;
+}
+
+/// Find a checkpoint to start counting virtual columns in line "lnum" of
+/// "wp" from, before byte "col" and virtual column "vcol".  Only valid when
+/// init_charsize_arg() returns kCharsizeFast, like the checkpoints are only
+/// added by getvcol() then.
+///
+/// @return  false when there is no such checkpoint.
+bool vcol_checkpoint_find(win_T *wp, linenr_T lnum, colnr_T col, colnr_T vcol, colnr_T *cp_col,
+                          colnr_T *cp_vcol)
+{
+  if (!vcol_cache_valid(wp, lnum)) {
+    return false;
+  }
+  return vcol_cache_find(&wp->w_vcol_cache, col, vcol, cp_col, cp_vcol);
+}
+
+/// Forget the checkpoints of virtual columns in "wp" from byte "col" of
+/// lines "lnum" to "lnume - 1", or in all lines from "lnum" when "xtra" lines
+/// were inserted or deleted.
+void vcol_checkpoint_invalidate(win_T *wp, linenr_T lnum, colnr_T col, linenr_T lnume,
+                                linenr_T xtra)
+{
+  vcol_cache_T *const vc = &wp->w_vcol_cache;
+  // changed() has just incremented b:changedtick.  Points that were not
+  // valid for the text before this change cannot be kept.
+  const varnumber_T changedtick = buf_get_changedtick(wp->w_buffer);
+  if (vc->vc_changedtick != changedtick - 1) {
+    vc->vc_lnum = 0;
+    return;
+  }
+  vc->vc_changedtick = changedtick;
+  if (vc->vc_lnum < lnum || (xtra == 0 && vc->vc_lnum >= lnume)) {
+    return;
+  }
+  if (xtra != 0 || vc->vc_lnum != lnum || lnume != lnum + 1) {
+    vc->vc_lnum = 0;
+    return;
+  }
+  // A checkpoint only depends on the text before it, but the character at
+  // "col" may have become part of the previous one.
+  while (kv_size(vc->vc_points) > 0 && kv_last(vc->vc_points).vp_col >= col) {
+    kv_size(vc->vc_points)--;
+  }
+}
+
+/// Forget the checkpoints of virtual columns of "wp", when it starts showing
+/// a buffer.
+void vcol_checkpoint_clear(win_T *wp)
+{
+  wp->w_vcol_cache.vc_lnum = 0;
+}
+
+/// Free the checkpoints of virtual columns of "wp".
+void vcol_checkpoint_free(win_T *wp)
+{
+  kv_destroy(wp->w_vcol_cache.vc_points);
+  wp->w_vcol_cache.vc_lnum = 0;
+}
+
 /// Get virtual column number of pos.
 ///  start: on the first position of this character (TAB, ctrl)
 /// cursor: where the cursor is on this character (first char, except for TAB)
@@ -524,6 +677,14 @@ void getvcol(win_T *wp, pos_T *pos, colnr_T *start, colnr_T *cursor, colnr_T *en
   StrCharInfo ci = utf_ptr2StrCharInfo(line);
   if (cstype == kCharsizeFast) {
     bool const use_tabstop = csarg.use_tabstop;
+    // In a long line start at the last checkpoint before "pos" and add
+    // checkpoints for the part of the line that hasn't been seen yet.
+    vcol_cache_T *const vc = vcol_cache_get(wp, pos->lnum);
+    colnr_T cp_col;
+    if (vc != NULL && vcol_cache_find(vc, end_col, MAXCOL, &cp_col, &vcol)) {
+      ci = utf_ptr2StrCharInfo(line + cp_col);
+    }
+    colnr_T next_cp = vcol_cache_next(vc);
     while (true) {
       if (*ci.ptr == NUL) {
         // if cursor is at NUL, it is treated like 1 cell char
@@ -537,6 +698,11 @@ void getvcol(win_T *wp, pos_T *pos, colnr_T *start, colnr_T *cursor, colnr_T *en
       }
       ci = next;
       vcol += char_size.width;
+      if (ci.ptr - line >= next_cp) {
+        kv_push(vc->vc_points, ((vcol_point_T){ .vp_col = (colnr_T)(ci.ptr - line),
+                                                .vp_vcol = vcol }));
+        next_cp = vcol_cache_next(vc);
+      }
     }
   } else {
     while (true) {
@@ -763,7 +929,77 @@ int plines_win_nofill(win_T *wp, linenr_T lnum, bool limit_winheight)
 
 /// Get number of window lines physical line "lnum" will occupy in window "wp".
 /// Does not care about folding, 'wrap' or filler lines.
+/// The height of long lines is cached in "wp".
 int plines_win_nofold(win_T *wp, linenr_T lnum)
+{
+  buf_T *const buf = wp->w_buffer;
+  const colnr_T len = ml_get_buf_len(buf, lnum);
+  if (len < PLINES_CACHE_MINLEN || buf_meta_total(buf, kMTMetaInline) > 0) {
+    return plines_win_nofold_nocache(wp, lnum);
+  }
+
+  plines_entry_T *const entry = plines_cache_entry(wp, lnum);
+  if (entry->pe_lnum != lnum || entry->pe_len != len) {
+    entry->pe_height = plines_win_nofold_nocache(wp, lnum);
+    entry->pe_lnum = lnum;
+    entry->pe_len = len;
+  }
+  return entry->pe_height;
+}
+
+/// Get the cache entry of "wp" for line "lnum", which may hold the height of
+/// another line.  Clears the cache when it is for another buffer, text width
+/// or options.
+static plines_entry_T *plines_cache_entry(win_T *wp, linenr_T lnum)
+{
+  plines_cache_T *const cache = &wp->w_plines_cache;
+  const int width = wp->w_width_inner - win_col_off(wp);
+  const int width2 = win_col_off2(wp);
+
+  if (cache->pc_entries == NULL) {
+    cache->pc_entries = xcalloc(PLINES_CACHE_SIZE, sizeof(*cache->pc_entries));
+  } else if (cache->pc_buf != wp->w_buffer->handle || cache->pc_width != width
+             || cache->pc_width2 != width2 || cache->pc_gen != plines_cache_gen) {
+    memset(cache->pc_entries, 0, PLINES_CACHE_SIZE * sizeof(*cache->pc_entries));
+  }
+  cache->pc_buf = wp->w_buffer->handle;
+  cache->pc_width = width;
+  cache->pc_width2 = width2;
+  cache->pc_gen = plines_cache_gen;
+
+  return &cache->pc_entries[lnum & (PLINES_CACHE_SIZE - 1)];
+}
+
+/// Forget the cached heights of lines "lnum" to "lnume - 1" in "wp", or of
+/// all lines from "lnum" when "xtra" lines were inserted or deleted.
+void plines_cache_invalidate(win_T *wp, linenr_T lnum, linenr_T lnume, linenr_T xtra)
+{
+  plines_entry_T *const entries = wp->w_plines_cache.pc_entries;
+  if (entries == NULL) {
+    return;
+  }
+  for (int i = 0; i < PLINES_CACHE_SIZE; i++) {
+    if (entries[i].pe_lnum >= lnum && (xtra != 0 || entries[i].pe_lnum < lnume)) {
+      entries[i].pe_lnum = 0;
+    }
+  }
+}
+
+/// Forget the cached heights of lines in all windows.  To be called when an
+/// option changes how lines are wrapped.
+void plines_cache_invalidate_all(void)
+{
+  plines_cache_gen++;
+}
+
+/// Free the cache of line heights of "wp".
+void plines_cache_free(win_T *wp)
+{
+  XFREE_CLEAR(wp->w_plines_cache.pc_entries);
+}
+
+/// Like plines_win_nofold(), without using the cache.
+static int plines_win_nofold_nocache(win_T *wp, linenr_T lnum)
 {
   char *s = ml_get_buf(wp->w_buffer, lnum);
   CharsizeArg csarg;
@@ -1879,7 +1879,7 @@ static int qf_add_entry(qf_list_T *qfl, char *dir, char *fname, char *module, in
                         char vis_col, char *pattern, int nr, char type, typval_T *user_data,
                         char valid)
 {
-  qfline_T *qfp = xmalloc(sizeof(qfline_T));
+  qfline_T *qfp = pool_alloc(sizeof(qfline_T));
 
   if (bufnum != 0) {
     buf_T *buf = buflist_findnr(bufnum);
@@ -3457,7 +3457,7 @@ static void qf_free_items(qf_list_T *qfl)
       xfree(qfp->qf_pattern);
       tv_clear(&qfp->qf_user_data);
       stop = (qfp == qfpnext);
-      xfree(qfp);
+      pool_free(qfp, sizeof(qfline_T));
       if (stop) {
         // Somehow qf_count may have an incorrect value, set it to 1
         // to avoid crashing when it's wrong.
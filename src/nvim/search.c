@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "klib/kvec.h"
 #include "nvim/ascii_defs.h"
 #include "nvim/autocmd.h"
 #include "nvim/autocmd_defs.h"
@@ -34,6 +35,7 @@
 #include "nvim/indent_c.h"
 #include "nvim/insexpand.h"
 #include "nvim/macros_defs.h"
+#include "nvim/map_defs.h"
 #include "nvim/mark.h"
 #include "nvim/mark_defs.h"
 #include "nvim/mbyte.h"
@@ -1699,6 +1701,44 @@ static void find_mps_values(int *initc, int *findc, bool *backwards, bool switch
   }
 }
 
+/// Results of backward searches for an unmatched '{', kept while reindenting
+/// a range of lines.  Once such a search has moved to the end of a line that
+/// doesn't end in a backslash, what it finds only depends on that line, the
+/// lines above it and the number of unmatched '}' seen so far.  Later
+/// searches that get to the same line with the same count can stop there.
+static struct {
+  buf_T *buf;                       ///< buffer being reindented, or NULL
+  Map(uint64_t, uint64_t) results;  ///< line and count -> found position
+  linenr_T max_lnum;                ///< largest line number in "results"
+  kvec_t(uint64_t) visited;         ///< line and count of current search
+} findmatch_memo = { .results = MAP_INIT };
+
+/// Start remembering the results of searches for an unmatched '{' in
+/// "buf".  Only lines above the line being changed may be used.
+void findmatch_memo_start(buf_T *buf)
+{
+  findmatch_memo.buf = buf;
+  findmatch_memo.max_lnum = 0;
+}
+
+/// Stop remembering the results of searches for an unmatched '{'.
+void findmatch_memo_stop(void)
+{
+  findmatch_memo.buf = NULL;
+  map_destroy(uint64_t, &findmatch_memo.results);
+  kv_destroy(findmatch_memo.visited);
+}
+
+/// Forget the remembered search results that depend on line "lnum", which
+/// was changed.
+void findmatch_memo_changed(linenr_T lnum)
+{
+  if (findmatch_memo.max_lnum >= lnum) {
+    map_clear(uint64_t, &findmatch_memo.results);
+    findmatch_memo.max_lnum = 0;
+  }
+}
+
 // findmatchlimit -- find the matching paren or brace, if it exists within
 // maxtravel lines of the cursor.  A maxtravel of 0 means search until falling
 // off the edge of the file.
@@ -1718,6 +1758,28 @@ static void find_mps_values(int *initc, int *findc, bool *backwards, bool switch
 // "oap" is only used to set oap->motion_type for a linewise motion, it can be
 // NULL
 pos_T *findmatchlimit(oparg_T *oap, int initc, int flags, int64_t maxtravel)
+{
+  const bool use_memo = findmatch_memo.buf == curbuf && initc == '{'
+                        && flags == FM_BLOCKSTOP && maxtravel == 0;
+  kv_size(findmatch_memo.visited) = 0;
+  pos_T *const pos = findmatchlimit_scan(oap, initc, flags, maxtravel, use_memo);
+
+  if (use_memo && !got_int) {
+    // Every line the search moved to leads to the same result.
+    const uint64_t result = pos == NULL ? 0 : ((uint64_t)pos->lnum << 32) | (uint32_t)pos->col;
+    for (size_t i = 0; i < kv_size(findmatch_memo.visited); i++) {
+      const uint64_t key = kv_A(findmatch_memo.visited, i);
+      map_put(uint64_t, uint64_t)(&findmatch_memo.results, key, result);
+      findmatch_memo.max_lnum = MAX(findmatch_memo.max_lnum, (linenr_T)(key >> 32));
+    }
+  }
+  return pos;
+}
+
+/// Implementation of findmatchlimit().  When "use_memo" is true, use and add
+/// to the results of earlier searches for an unmatched '{'.
+static pos_T *findmatchlimit_scan(oparg_T *oap, int initc, int flags, int64_t maxtravel,
+                                  bool use_memo)
 {
   static pos_T pos;                     // current search position
   int findc = 0;                        // matching brace
@@ -1962,6 +2024,25 @@ pos_T *findmatchlimit(oparg_T *oap, int initc, int flags, int64_t maxtravel)
         do_quotes = -1;
         line_breakcheck();
 
+        // Quotes don't continue from this line to the next one, and the
+        // start position no longer matters: earlier searches that got here
+        // with the same count found the same '{'.
+        if (use_memo && backwards && !lisp && start_in_quotes != kNone
+            && (pos.col == 0 || linep[pos.col - 1] != '\\')) {
+          const uint64_t key = ((uint64_t)pos.lnum << 32) | (uint32_t)count;
+          uint64_t *const result = map_ref(uint64_t, uint64_t)(&findmatch_memo.results, key,
+                                                               NULL);
+          if (result != NULL) {
+            if (*result == 0) {
+              return NULL;
+            }
+            pos.lnum = (linenr_T)(*result >> 32);
+            pos.col = (colnr_T)(*result & UINT32_MAX);
+            return &pos;
+          }
+          kv_push(findmatch_memo.visited, key);
+        }
+
         // Check if this line contains a single-line comment
         if (comment_dir || lisp) {
           comment_col = check_linecomment(linep);
@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "klib/kvec.h"
 #include "nvim/api/private/defs.h"
 #include "nvim/api/private/helpers.h"
 #include "nvim/ascii_defs.h"
@@ -62,6 +63,21 @@ typedef enum {
   kNumBaseHexadecimal = 16,
 } NumberBase;
 
+/// Items whose value depends on the cursor position, the mode or the Visual
+/// area: they change when show_cursor_info_later() notices a change.
+static const char stl_cursor_items[] = {
+  STL_COLUMN, STL_VIRTCOL, STL_VIRTCOL_ALT, STL_LINE, STL_NUMLINES, STL_OFFSET,
+  STL_OFFSET_X, STL_BYTEVAL, STL_BYTEVAL_X, STL_PERCENTAGE, STL_ALTPERCENT,
+  STL_SHOWCMD, NUL,
+};
+
+/// What the last build_stl_str_hl() call used.
+enum {
+  kStlUsedCursor = 1,  ///< an item in stl_cursor_items
+  kStlUsedExpr = 2,    ///< an expression, "%!" or "%{}"
+};
+static int stl_last_used = 0;
+
 /// Redraw the status line of window `wp`.
 ///
 /// If inversion is possible we use it. Else '=' characters are used.
@@ -416,6 +432,13 @@ static void win_redr_custom(win_T *wp, bool draw_winbar, bool draw_ruler)
   xfree(stl);
   ewp->w_p_crb = p_crb_save;
 
+  // An expression may show anything, assume it depends on the cursor.
+  if (opt_idx == kOptStatusline) {
+    wp->w_stl_nocursor = stl_last_used == 0;
+  } else if (opt_idx == kOptWinbar) {
+    wp->w_wbr_nocursor = stl_last_used == 0;
+  }
+
   int len = (int)strlen(buf);
   int start_col = col;
 
@@ -877,12 +900,46 @@ int build_statuscol_str(win_T *wp, linenr_T lnum, linenr_T relnum, char *buf, st
     set_vim_var_nr(VV_RELNUM, relnum);
   }
 
+  // The screen lines after the first one of line "lnum" all look the same,
+  // unless an expression uses v:virtnum.  Build the string for them once.
+  // Not shared between filler and wrapped lines: v:lnum is only set for the
+  // line itself, e.g. "%C" may show another fold above it.
+  static char virt_buf[MAXPATHL];
+  static kvec_t(struct { ptrdiff_t off; int userhl; }) virt_hlrec = KV_INITIAL_VALUE;
+  const bool filler = get_vim_var_nr(VV_VIRTNUM) < 0;
+  if (relnum < 0 && stcp->virt_valid && stcp->virt_filler == filler
+      && stcp->virt_maxwidth == stcp->width) {
+    xstrlcpy(buf, virt_buf, MAXPATHL);
+    // "stcp->hlrec" is the array the saved items were built in, it is
+    // large enough for them.
+    for (size_t i = 0; i < kv_size(virt_hlrec); i++) {
+      stcp->hlrec[i].start = buf + kv_A(virt_hlrec, i).off;
+      stcp->hlrec[i].userhl = kv_A(virt_hlrec, i).userhl;
+    }
+    stcp->hlrec[kv_size(virt_hlrec)].start = NULL;
+    return stcp->virt_width;
+  }
+
   StlClickRecord *clickrec;
   char *stc = xstrdup(wp->w_p_stc);
   int width = build_stl_str_hl(wp, buf, MAXPATHL, stc, kOptStatuscolumn, OPT_LOCAL, 0,
                                stcp->width, &stcp->hlrec, NULL, fillclick ? &clickrec : NULL, stcp);
   xfree(stc);
 
+  if (relnum < 0 && !(stl_last_used & kStlUsedExpr) && *wp->w_p_stc != NUL) {
+    xstrlcpy(virt_buf, buf, MAXPATHL);
+    kv_size(virt_hlrec) = 0;
+    for (stl_hlrec_t *sp = stcp->hlrec; sp->start != NULL; sp++) {
+      kv_pushp(virt_hlrec);
+      kv_last(virt_hlrec).off = sp->start - buf;
+      kv_last(virt_hlrec).userhl = sp->userhl;
+    }
+    stcp->virt_valid = true;
+    stcp->virt_filler = filler;
+    stcp->virt_maxwidth = stcp->width;
+    stcp->virt_width = width;
+  }
+
   if (fillclick) {
     stl_clear_click_defs(wp->w_statuscol_click_defs, wp->w_statuscol_click_defs_size);
     wp->w_statuscol_click_defs = stl_alloc_click_defs(wp->w_statuscol_click_defs, width,
@@ -941,6 +998,7 @@ int build_stl_str_hl(win_T *wp, char *out, size_t outlen, char *fmt, OptIndex op
   // matter?
   // const int called_emsg_before = called_emsg;
   const int did_emsg_before = did_emsg;
+  int used = 0;
 
   // When inside update_screen() we do not want redrawing a statusline,
   // ruler, title, etc. to trigger another redraw, it may cause an endless
@@ -969,6 +1027,7 @@ int build_stl_str_hl(win_T *wp, char *out, size_t outlen, char *fmt, OptIndex op
   // When the format starts with "%!" then evaluate it as an expression and
   // use the result as the actual format string.
   if (fmt[0] == '%' && fmt[1] == '!') {
+    used |= kStlUsedExpr;
     typval_T tv = {
       .v_type = VAR_NUMBER,
       .vval.v_number = wp->handle,
@@ -1373,6 +1432,11 @@ int build_stl_str_hl(win_T *wp, char *out, size_t outlen, char *fmt, OptIndex op
 
     // The status line item type
     char opt = *fmt_p++;
+    if (opt == STL_VIM_EXPR) {
+      used |= kStlUsedExpr;
+    } else if (vim_strchr(stl_cursor_items, (uint8_t)opt) != NULL) {
+      used |= kStlUsedCursor;
+    }
 
     // OK - now for the real work
     NumberBase base = kNumBaseDecimal;
@@ -1965,6 +2029,8 @@ int build_stl_str_hl(win_T *wp, char *out, size_t outlen, char *fmt, OptIndex op
   if (usefmt != fmt) {
     xfree(usefmt);
   }
+  // Set after evaluating expressions, which may build another status line.
+  stl_last_used = used;
 
   // We have now processed the entire statusline format string.
   // What follows is post-processing to handle alignment and highlighting.
@@ -63,4 +63,9 @@ typedef struct {
   stl_hlrec_t *hlrec;                  ///< highlight groups
   foldinfo_T foldinfo;                 ///< fold information
   SignTextAttrs *sattrs;               ///< sign attributes
+  bool virt_valid;                     ///< string for the screen lines after
+                                       ///< the first one was saved
+  bool virt_filler;                    ///< it was built for a filler line
+  int virt_maxwidth;                   ///< "width" it was built for
+  int virt_width;                      ///< its width
 } statuscol_T;
@@ -35,6 +35,7 @@
 #include "nvim/mbyte.h"
 #include "nvim/memline.h"
 #include "nvim/memory.h"
+#include "nvim/memory_defs.h"
 #include "nvim/message.h"
 #include "nvim/option_vars.h"
 #include "nvim/optionstr.h"
@@ -885,6 +886,20 @@ static void syn_stack_free_block(synblock_T *block)
   block->b_sst_first = NULL;
   block->b_sst_len = 0;
 }
+
+/// Add the syntax state stack of "block" to "gauge", counting the used
+/// entries.
+void syn_mem_usage(synblock_T *block, MemGauge *gauge)
+{
+  gauge->bytes += (size_t)block->b_sst_len * sizeof(synstate_T);
+  for (synstate_T *p = block->b_sst_first; p != NULL; p = p->sst_next) {
+    gauge->count++;
+    if (p->sst_stacksize > SST_FIX_STATES) {
+      gauge->bytes += (size_t)p->sst_union.sst_ga.ga_maxlen * sizeof(bufstate_T);
+    }
+  }
+}
+
 // Free b_sst_array[] for buffer "buf".
 // Used when syntax items changed to force resyncing everywhere.
 void syn_stack_free_all(synblock_T *block)
@@ -66,6 +66,7 @@
 #include "nvim/ex_docmd.h"
 #include "nvim/getchar.h"
 #include "nvim/globals.h"
+#include "nvim/hashtab.h"
 #include "nvim/highlight.h"
 #include "nvim/highlight_defs.h"
 #include "nvim/highlight_group.h"
@@ -76,6 +77,7 @@
 #include "nvim/mbyte.h"
 #include "nvim/memline.h"
 #include "nvim/memory.h"
+#include "nvim/memory_defs.h"
 #include "nvim/mouse.h"
 #include "nvim/move.h"
 #include "nvim/msgpack_rpc/channel_defs.h"
@@ -85,6 +87,7 @@
 #include "nvim/option_defs.h"
 #include "nvim/option_vars.h"
 #include "nvim/optionstr.h"
+#include "nvim/os/time.h"
 #include "nvim/pos_defs.h"
 #include "nvim/state.h"
 #include "nvim/state_defs.h"
@@ -111,15 +114,54 @@ typedef struct {
 // Delay for refreshing the terminal buffer after receiving updates from
 // libvterm. Improves performance when receiving large bursts of data.
 #define REFRESH_DELAY 10
+// Upper bound for the refresh delay. When refreshing takes long (a terminal
+// streaming output at full speed), the delay is stretched so that terminal
+// refreshes use at most 1/REFRESH_BUDGET_RATIO of the main loop's time and
+// editing in other windows stays responsive.
+#define REFRESH_DELAY_MAX 100
+#define REFRESH_BUDGET_RATIO 4
 
 static TimeWatcher refresh_timer;
 static bool refresh_pending = false;
+static uint64_t refresh_delay = REFRESH_DELAY;
 
+// Run of consecutive scrollback cells sharing the same attributes.
 typedef struct {
-  size_t cols;
-  VTermScreenCell cells[];
+  uint32_t cells;  // number of columns covered by the run
+  VTermScreenCellAttrs attrs;
+  VTermColor fg, bg;
+} ScrollbackAttrRun;
+
+// Compact encoding of a line that scrolled off the top of the screen. Storing
+// full VTermScreenCells costs dozens of bytes per column, so the line is kept
+// as UTF-8 text (one character per cell, trailing empty cells dropped) plus
+// run-length encoded attributes. Lines containing wide or multi-codepoint
+// cells additionally carry one info byte per non-continuation cell.
+//
+// Layout of `data`: runs[nruns], text[text_len], cellinfo[ncells] (optional)
+typedef struct {
+  uint32_t cols;      // width of the terminal when the line was pushed
+  uint32_t nruns;     // number of ScrollbackAttrRun entries
+  uint32_t text_len;  // bytes of UTF-8 text
+  uint32_t ncells;    // cells described by text (0 unless cellinfo is used)
+  char data[];
 } ScrollbackLine;
 
+// cellinfo byte: number of codepoints in the cell, and whether it is wide.
+#define SB_CELL_WIDE 0x80
+#define SB_CELL_NCHARS(c) ((c) & 0x7f)
+
+#define SB_RUNS(sbrow) ((ScrollbackAttrRun *)(sbrow)->data)
+#define SB_TEXT(sbrow) ((sbrow)->data + (sbrow)->nruns * sizeof(ScrollbackAttrRun))
+#define SB_CELLINFO(sbrow) ((uint8_t *)SB_TEXT(sbrow) + (sbrow)->text_len)
+
+typedef struct {
+  hash_T text_hash;   // hash of the buffer line text
+  size_t text_len;    // length of the buffer line text
+  bool text_valid;    // buffer line is known to hold the text described above
+  bool attrs_valid;   // attrs for this row are cached
+} TermRowCache;
+
 struct terminal {
   TerminalOptions opts;  // options passed to terminal_open
   VTerm *vt;
@@ -129,7 +171,8 @@ struct terminal {
   //  - receive data from libvterm as a result of key presses.
   char textbuf[0x1fff];
 
-  ScrollbackLine **sb_buffer;       // Scrollback storage.
+  ScrollbackLine **sb_buffer;       // Scrollback storage (circular buffer).
+  size_t sb_start;                  // Index of the most recent line in sb_buffer.
   size_t sb_current;                // Lines stored in sb_buffer.
   size_t sb_size;                   // Capacity of sb_buffer.
   // "virtual index" that points to the first sb_buffer row that we need to
@@ -163,6 +206,18 @@ struct terminal {
 
   bool color_set[16];
 
+  // Per-row cache of the visible screen, invalidated by damage:
+  //  - hash of the text last written to the buffer line, so refresh_screen()
+  //    can skip rows whose text did not change (e.g. cursor movement).
+  //  - highlight attributes computed by terminal_get_line_attributes().
+  struct {
+    int rows, cols;           // dimensions the cache was allocated for
+    TermRowCache *row;        // per-row state
+    int *attrs;               // rows * cols attribute ids
+    varnumber_T changedtick;  // buffer changedtick after the last refresh
+    int hl_generation;        // hl_attr_generation the attrs were computed with
+  } cache;
+
   // When there is a pending TermRequest autocommand, block and store input.
   StringBuilder *pending_send;
 
@@ -358,6 +413,7 @@ void terminal_open(Terminal **termpp, buf_T *buf, TerminalOptions opts)
     }
     // Configure the scrollback buffer.
     term->sb_size = (size_t)buf->b_p_scbk;
+    term->sb_start = 0;
     term->sb_buffer = xmalloc(sizeof(ScrollbackLine *) * term->sb_size);
   }
 
@@ -765,9 +821,11 @@ void terminal_destroy(Terminal **termpp)
       set_del(ptr_t, &invalidated_terminals, term);
     }
     for (size_t i = 0; i < term->sb_current; i++) {
-      xfree(term->sb_buffer[i]);
+      xfree(*sb_line(term, i));
     }
     xfree(term->sb_buffer);
+    xfree(term->cache.row);
+    xfree(term->cache.attrs);
     xfree(term->title);
     vterm_free(term->vt);
     xfree(term);
@@ -938,10 +996,44 @@ void terminal_get_line_attributes(Terminal *term, win_T *wp, int linenr, int *te
     return;
   }
 
+  // Scrollback rows are decoded from their attribute runs.
+  ScrollbackLine *sbrow = row < 0 ? *sb_line(term, (size_t)(-row - 1)) : NULL;
+  const ScrollbackAttrRun *runs = sbrow ? SB_RUNS(sbrow) : NULL;
+  size_t run = 0;
+  int run_end = (sbrow && sbrow->nruns) ? (int)runs[0].cells : 0;
+
   width = MIN(TERM_ATTRS_MAX, width);
+
+  int *cached_attrs = NULL;
+  if (row >= 0) {
+    row_cache_ensure(term);
+    cached_attrs = term->cache.attrs + (size_t)row * (size_t)term->cache.cols;
+    if (term->cache.row[row].attrs_valid) {
+      memcpy(term_attrs, cached_attrs, sizeof(int) * (size_t)width);
+      add_cursor_attr(term, wp, row, term_attrs);
+      return;
+    }
+  }
+
   for (int col = 0; col < width; col++) {
     VTermScreenCell cell;
-    bool color_valid = fetch_cell(term, row, col, &cell);
+    bool color_valid = true;
+    if (sbrow) {
+      while (col >= run_end && run + 1 < sbrow->nruns) {
+        run_end += (int)runs[++run].cells;
+      }
+      color_valid = col < run_end;
+      if (color_valid) {
+        cell.attrs = runs[run].attrs;
+        cell.fg = runs[run].fg;
+        cell.bg = runs[run].bg;
+      } else {
+        // fill with an empty cell
+        cell = (VTermScreenCell) { .chars = { 0 }, .width = 1 };
+      }
+    } else {
+      fetch_cell(term, row, col, &cell);
+    }
     bool fg_default = !color_valid || VTERM_COLOR_IS_DEFAULT_FG(&cell.fg);
     bool bg_default = !color_valid || VTERM_COLOR_IS_DEFAULT_BG(&cell.bg);
 
@@ -982,16 +1074,26 @@ void terminal_get_line_attributes(Terminal *term, win_T *wp, int linenr, int *te
       });
     }
 
-    if (term->cursor.visible && term->cursor.row == row
-        && term->cursor.col == col) {
-      attr_id = hl_combine_attr(attr_id,
-                                is_focused(term) && wp == curwin
-                                ? win_hl_attr(wp, HLF_TERM)
-                                : win_hl_attr(wp, HLF_TERMNC));
-    }
-
     term_attrs[col] = attr_id;
   }
+
+  if (cached_attrs) {
+    memcpy(cached_attrs, term_attrs, sizeof(int) * (size_t)width);
+    term->cache.row[row].attrs_valid = true;
+  }
+  add_cursor_attr(term, wp, row, term_attrs);
+}
+
+static void add_cursor_attr(Terminal *term, win_T *wp, int row, int *term_attrs)
+{
+  int col = term->cursor.col;
+  if (term->cursor.visible && term->cursor.row == row
+      && col >= 0 && col < TERM_ATTRS_MAX) {
+    term_attrs[col] = hl_combine_attr(term_attrs[col],
+                                      is_focused(term) && wp == curwin
+                                      ? win_hl_attr(wp, HLF_TERM)
+                                      : win_hl_attr(wp, HLF_TERMNC));
+  }
 }
 
 Buffer terminal_buf(const Terminal *term)
@@ -1004,19 +1106,34 @@ bool terminal_running(const Terminal *term)
   return !term->closed;
 }
 
+/// Add the scrollback of "term" to "gauge", counting the lines.
+void terminal_mem_usage(Terminal *term, MemGauge *gauge)
+{
+  gauge->bytes += term->sb_size * sizeof(ScrollbackLine *);
+  for (size_t i = 0; i < term->sb_current; i++) {
+    ScrollbackLine *sbrow = *sb_line(term, i);
+    gauge->count++;
+    gauge->bytes += sizeof(ScrollbackLine) + sbrow->nruns * sizeof(ScrollbackAttrRun)
+                    + sbrow->text_len + sbrow->ncells;
+  }
+}
+
 // }}}
 // libvterm callbacks {{{
 
 static int term_damage(VTermRect rect, void *data)
 {
+  row_cache_invalidate_attrs(data, rect.start_row, rect.end_row);
   invalidate_terminal(data, rect.start_row, rect.end_row);
   return 1;
 }
 
 static int term_moverect(VTermRect dest, VTermRect src, void *data)
 {
-  invalidate_terminal(data, MIN(dest.start_row, src.start_row),
-                      MAX(dest.end_row, src.end_row));
+  int start_row = MIN(dest.start_row, src.start_row);
+  int end_row = MAX(dest.end_row, src.end_row);
+  row_cache_invalidate_attrs(data, start_row, end_row);
+  invalidate_terminal(data, start_row, end_row);
   return 1;
 }
 
@@ -1104,6 +1221,185 @@ static int term_bell(void *data)
   return 1;
 }
 
+/// Gets the scrollback storage slot of a line.
+///
+/// @param idx  Index of the line, 0 being the most recently pushed one.
+static ScrollbackLine **sb_line(Terminal *term, size_t idx)
+{
+  assert(idx < term->sb_current);
+  return &term->sb_buffer[(term->sb_start + idx) % term->sb_size];
+}
+
+static bool sb_cell_attrs_equal(const VTermScreenCell *a, const VTermScreenCell *b)
+{
+  const VTermScreenCellAttrs *x = &a->attrs;
+  const VTermScreenCellAttrs *y = &b->attrs;
+  return x->bold == y->bold && x->underline == y->underline && x->italic == y->italic
+         && x->blink == y->blink && x->reverse == y->reverse && x->conceal == y->conceal
+         && x->strike == y->strike && x->font == y->font && x->dwl == y->dwl
+         && x->dhl == y->dhl && x->small == y->small && x->baseline == y->baseline
+         && vterm_color_is_equal(&a->fg, &b->fg) && vterm_color_is_equal(&a->bg, &b->bg);
+}
+
+static bool sb_cell_is_empty(const VTermScreenCell *cell)
+{
+  return cell->chars[0] == 0 || cell->chars[0] == (uint32_t)-1;
+}
+
+/// Encodes a row of vterm cells into a newly allocated ScrollbackLine.
+static ScrollbackLine *sb_line_encode(int cols, const VTermScreenCell *cells)
+{
+  // First pass: measure text, attribute runs and whether cellinfo is needed.
+  size_t nruns = 0;
+  for (int col = 0; col < cols; col++) {
+    if (col == 0 || !sb_cell_attrs_equal(&cells[col], &cells[col - 1])) {
+      nruns++;
+    }
+  }
+  size_t text_len = 0;
+  size_t trimmed_len = 0;  // text_len up to the last non-empty cell
+  size_t ncells = 0;
+  size_t trimmed_cells = 0;
+  bool need_info = false;
+  char tmp[MB_MAXCHAR];
+  for (int col = 0; col < cols; col += MAX(cells[col].width, 1)) {
+    const VTermScreenCell *cell = &cells[col];
+    ncells++;
+    if (sb_cell_is_empty(cell)) {
+      text_len++;  // stored as a space when followed by non-empty cells
+      continue;
+    }
+    int nchars = 0;
+    for (; nchars < VTERM_MAX_CHARS_PER_CELL && cell->chars[nchars]; nchars++) {
+      text_len += (size_t)utf_char2bytes((int)cell->chars[nchars], tmp);
+    }
+    need_info |= nchars > 1 || cell->width > 1;
+    trimmed_len = text_len;
+    trimmed_cells = ncells;
+  }
+
+  size_t info_len = need_info ? trimmed_cells : 0;
+  ScrollbackLine *sbrow = xmalloc(sizeof(ScrollbackLine) + nruns * sizeof(ScrollbackAttrRun)
+                                  + trimmed_len + info_len);
+  sbrow->cols = (uint32_t)cols;
+  sbrow->nruns = (uint32_t)nruns;
+  sbrow->text_len = (uint32_t)trimmed_len;
+  sbrow->ncells = (uint32_t)info_len;
+
+  // Second pass: fill in runs, text and cellinfo.
+  ScrollbackAttrRun *runs = SB_RUNS(sbrow);
+  size_t run = 0;
+  for (int col = 0; col < cols; col++) {
+    if (col == 0 || !sb_cell_attrs_equal(&cells[col], &cells[col - 1])) {
+      runs[run++] = (ScrollbackAttrRun) {
+        .cells = 0, .attrs = cells[col].attrs, .fg = cells[col].fg, .bg = cells[col].bg
+      };
+    }
+    runs[run - 1].cells++;
+  }
+  assert(run == nruns);
+
+  char *text = SB_TEXT(sbrow);
+  uint8_t *info = SB_CELLINFO(sbrow);
+  size_t off = 0;
+  size_t cell_idx = 0;
+  for (int col = 0; col < cols && cell_idx < trimmed_cells;
+       col += MAX(cells[col].width, 1), cell_idx++) {
+    const VTermScreenCell *cell = &cells[col];
+    if (sb_cell_is_empty(cell)) {
+      text[off++] = ' ';
+      if (need_info) {
+        info[cell_idx] = 1;
+      }
+      continue;
+    }
+    int nchars = 0;
+    for (; nchars < VTERM_MAX_CHARS_PER_CELL && cell->chars[nchars]; nchars++) {
+      off += (size_t)utf_char2bytes((int)cell->chars[nchars], text + off);
+    }
+    if (need_info) {
+      info[cell_idx] = (uint8_t)(nchars | (cell->width > 1 ? SB_CELL_WIDE : 0));
+    }
+  }
+  assert(off == trimmed_len);
+
+  return sbrow;
+}
+
+/// Decodes a ScrollbackLine back into vterm cells.
+static void sb_line_decode(const ScrollbackLine *sbrow, int cols, VTermScreenCell *cells)
+{
+  const ScrollbackAttrRun *runs = SB_RUNS(sbrow);
+  int col = 0;
+  for (size_t run = 0; run < sbrow->nruns && col < cols; run++) {
+    for (uint32_t i = 0; i < runs[run].cells && col < cols; i++, col++) {
+      cells[col] = (VTermScreenCell) {
+        .chars = { 0 },
+        .width = 1,
+        .attrs = runs[run].attrs,
+        .fg = runs[run].fg,
+        .bg = runs[run].bg,
+      };
+    }
+  }
+  for (; col < cols; col++) {
+    cells[col] = (VTermScreenCell) { .chars = { 0 }, .width = 1 };
+  }
+
+  const char *text = SB_TEXT(sbrow);
+  const uint8_t *info = sbrow->ncells ? SB_CELLINFO(sbrow) : NULL;
+  size_t off = 0;
+  size_t cell_idx = 0;
+  col = 0;
+  while (off < sbrow->text_len && col < cols) {
+    int nchars = info ? SB_CELL_NCHARS(info[cell_idx]) : 1;
+    bool wide = info && (info[cell_idx] & SB_CELL_WIDE);
+    for (int i = 0; i < nchars && off < sbrow->text_len; i++) {
+      int len = utf_ptr2len(text + off);
+      if (i < VTERM_MAX_CHARS_PER_CELL) {
+        cells[col].chars[i] = (uint32_t)utf_ptr2char(text + off);
+      }
+      off += (size_t)len;
+    }
+    if (wide && col + 1 < cols) {
+      cells[col].width = 2;
+      cells[col + 1].chars[0] = (uint32_t)-1;
+      col += 2;
+    } else {
+      col++;
+    }
+    cell_idx++;
+  }
+}
+
+/// Converts a ScrollbackLine into a buffer line in term->textbuf, truncated
+/// to `end_col` cells.
+static void sb_line_to_text(Terminal *term, const ScrollbackLine *sbrow, int end_col)
+{
+  const char *text = SB_TEXT(sbrow);
+  const uint8_t *info = sbrow->ncells ? SB_CELLINFO(sbrow) : NULL;
+  size_t len = sbrow->text_len;
+  if ((int)sbrow->cols > end_col) {
+    // Only the cells that fit in the current width are shown.
+    size_t off = 0;
+    int col = 0;
+    for (size_t cell_idx = 0; off < sbrow->text_len && col < end_col; cell_idx++) {
+      int nchars = info ? SB_CELL_NCHARS(info[cell_idx]) : 1;
+      for (int i = 0; i < nchars && off < sbrow->text_len; i++) {
+        off += (size_t)utf_ptr2len(text + off);
+      }
+      col += (info && (info[cell_idx] & SB_CELL_WIDE)) ? 2 : 1;
+    }
+    len = off;
+  }
+  if (len >= sizeof(term->textbuf)) {
+    len = sizeof(term->textbuf) - 1;
+    len -= (size_t)utf_head_off(text, text + len);
+  }
+  memcpy(term->textbuf, text, len);
+  term->textbuf[len] = NUL;
+}
+
 /// Scrollback push handler: called just before a line goes offscreen (and libvterm will forget it),
 /// giving us a chance to store it.
 ///
@@ -1116,42 +1412,21 @@ static int term_sb_push(int cols, const VTermScreenCell *cells, void *data)
     return 0;
   }
 
-  // copy vterm cells into sb_buffer
-  size_t c = (size_t)cols;
-  ScrollbackLine *sbrow = NULL;
+  // The new row becomes the start of the circular buffer. When the buffer is
+  // full, the slot before the start holds the oldest row, which is dropped.
+  size_t slot = (term->sb_start + term->sb_size - 1) % term->sb_size;
   if (term->sb_current == term->sb_size) {
-    if (term->sb_buffer[term->sb_current - 1]->cols == c) {
-      // Recycle old row if it's the right size
-      sbrow = term->sb_buffer[term->sb_current - 1];
-    } else {
-      xfree(term->sb_buffer[term->sb_current - 1]);
-    }
-
-    // Make room at the start by shifting to the right.
-    memmove(term->sb_buffer + 1, term->sb_buffer,
-            sizeof(term->sb_buffer[0]) * (term->sb_current - 1));
-  } else if (term->sb_current > 0) {
-    // Make room at the start by shifting to the right.
-    memmove(term->sb_buffer + 1, term->sb_buffer,
-            sizeof(term->sb_buffer[0]) * term->sb_current);
-  }
-
-  if (!sbrow) {
-    sbrow = xmalloc(sizeof(ScrollbackLine) + c * sizeof(sbrow->cells[0]));
-    sbrow->cols = c;
-  }
-
-  // New row is added at the start of the storage buffer.
-  term->sb_buffer[0] = sbrow;
-  if (term->sb_current < term->sb_size) {
+    xfree(term->sb_buffer[slot]);
+  } else {
     term->sb_current++;
   }
+  term->sb_start = slot;
+  term->sb_buffer[slot] = sb_line_encode(cols, cells);
 
   if (term->sb_pending < (int)term->sb_size) {
     term->sb_pending++;
   }
 
-  memcpy(sbrow->cells, cells, sizeof(cells[0]) * c);
   set_put(ptr_t, &invalidated_terminals, term);
 
   return 1;
@@ -1174,23 +1449,13 @@ static int term_sb_pop(int cols, VTermScreenCell *cells, void *data)
     term->sb_pending--;
   }
 
-  ScrollbackLine *sbrow = term->sb_buffer[0];
+  // Forget the "popped" row by advancing the start of the circular buffer.
+  ScrollbackLine *sbrow = term->sb_buffer[term->sb_start];
+  term->sb_start = (term->sb_start + 1) % term->sb_size;
   term->sb_current--;
-  // Forget the "popped" row by shifting the rest onto it.
-  memmove(term->sb_buffer, term->sb_buffer + 1,
-          sizeof(term->sb_buffer[0]) * (term->sb_current));
-
-  size_t cols_to_copy = (size_t)cols;
-  if (cols_to_copy > sbrow->cols) {
-    cols_to_copy = sbrow->cols;
-  }
 
   // copy to vterm state
-  memcpy(cells, sbrow->cells, sizeof(cells[0]) * cols_to_copy);
-  for (size_t col = cols_to_copy; col < (size_t)cols; col++) {
-    cells[col].chars[0] = 0;
-    cells[col].width = 1;
-  }
+  sb_line_decode(sbrow, cols, cells);
 
   xfree(sbrow);
   set_put(ptr_t, &invalidated_terminals, term);
@@ -1643,6 +1908,11 @@ end:
 
 static void fetch_row(Terminal *term, int row, int end_col)
 {
+  if (row < 0) {
+    sb_line_to_text(term, *sb_line(term, (size_t)(-row - 1)), end_col);
+    return;
+  }
+
   int col = 0;
   size_t line_len = 0;
   char *ptr = term->textbuf;
@@ -1667,25 +1937,10 @@ static void fetch_row(Terminal *term, int row, int end_col)
   term->textbuf[line_len] = NUL;
 }
 
-static bool fetch_cell(Terminal *term, int row, int col, VTermScreenCell *cell)
+static void fetch_cell(Terminal *term, int row, int col, VTermScreenCell *cell)
 {
-  if (row < 0) {
-    ScrollbackLine *sbrow = term->sb_buffer[-row - 1];
-    if ((size_t)col < sbrow->cols) {
-      *cell = sbrow->cells[col];
-    } else {
-      // fill the pointer with an empty cell
-      *cell = (VTermScreenCell) {
-        .chars = { 0 },
-        .width = 1,
-      };
-      return false;
-    }
-  } else {
-    vterm_screen_get_cell(term->vts, (VTermPos){ .row = row, .col = col },
-                          cell);
-  }
-  return true;
+  assert(row >= 0);
+  vterm_screen_get_cell(term->vts, (VTermPos){ .row = row, .col = col }, cell);
 }
 
 // queue a terminal instance for refresh
@@ -1698,7 +1953,7 @@ static void invalidate_terminal(Terminal *term, int start_row, int end_row)
 
   set_put(ptr_t, &invalidated_terminals, term);
   if (!refresh_pending) {
-    time_watcher_start(&refresh_timer, refresh_timer_cb, REFRESH_DELAY, 0);
+    time_watcher_start(&refresh_timer, refresh_timer_cb, refresh_delay, 0);
     refresh_pending = true;
   }
 }
@@ -1716,6 +1971,12 @@ static void refresh_terminal(Terminal *term)
   }
   linenr_T ml_before = buf->b_ml.ml_line_count;
 
+  // The buffer was changed by something else than the terminal, cached rows
+  // no longer describe its contents.
+  if (buf_get_changedtick(buf) != term->cache.changedtick) {
+    row_cache_invalidate_text(term);
+  }
+
   // refresh_ functions assume the terminal buffer is current
   aco_save_T aco;
   aucmd_prepbuf(&aco, buf);
@@ -1723,6 +1984,7 @@ static void refresh_terminal(Terminal *term)
   refresh_scrollback(term, buf);
   refresh_screen(term, buf);
   aucmd_restbuf(&aco);
+  term->cache.changedtick = buf_get_changedtick(buf);
 
   int ml_added = buf->b_ml.ml_line_count - ml_before;
   adjust_topline(term, buf, ml_added);
@@ -1737,6 +1999,7 @@ static void refresh_timer_cb(TimeWatcher *watcher, void *data)
   }
   Terminal *term;
   void *stub; (void)(stub);
+  uint64_t start = os_hrtime();
   // don't process autocommands while updating terminal buffers
   block_autocmds();
   set_foreach(&invalidated_terminals, term, {
@@ -1744,6 +2007,10 @@ static void refresh_timer_cb(TimeWatcher *watcher, void *data)
   });
   set_clear(ptr_t, &invalidated_terminals);
   unblock_autocmds();
+
+  uint64_t elapsed_ms = (os_hrtime() - start) / 1000000;
+  refresh_delay = MIN(MAX(elapsed_ms * (REFRESH_BUDGET_RATIO - 1), REFRESH_DELAY),
+                      REFRESH_DELAY_MAX);
 }
 
 static void refresh_size(Terminal *term, buf_T *buf)
@@ -1785,16 +2052,21 @@ static void adjust_scrollback(Terminal *term, buf_T *buf)
     size_t diff = term->sb_current - scbk;
     for (size_t i = 0; i < diff; i++) {
       ml_delete(1, false);
+      xfree(*sb_line(term, term->sb_current - 1));
       term->sb_current--;
-      xfree(term->sb_buffer[term->sb_current]);
     }
     deleted_lines(1, (linenr_T)diff);
   }
 
-  // Resize the scrollback storage.
-  size_t sb_region = sizeof(ScrollbackLine *) * scbk;
+  // Resize the scrollback storage, unwrapping the circular buffer.
   if (scbk != term->sb_size) {
-    term->sb_buffer = xrealloc(term->sb_buffer, sb_region);
+    ScrollbackLine **sb_buffer = xmalloc(sizeof(ScrollbackLine *) * scbk);
+    for (size_t i = 0; i < term->sb_current; i++) {
+      sb_buffer[i] = *sb_line(term, i);
+    }
+    xfree(term->sb_buffer);
+    term->sb_buffer = sb_buffer;
+    term->sb_start = 0;
   }
 
   term->sb_size = scbk;
@@ -1814,6 +2086,8 @@ static void refresh_scrollback(Terminal *term, buf_T *buf)
     ml_append(0, term->textbuf, 0, false);
     appended_lines(0, 1);
     term->sb_pending--;
+    // Lines of the visible screen were shifted down.
+    row_cache_invalidate_text(term);
   }
 
   row_offset -= term->sb_pending;
@@ -1849,7 +2123,6 @@ static void refresh_scrollback(Terminal *term, buf_T *buf)
 static void refresh_screen(Terminal *term, buf_T *buf)
 {
   assert(buf == curbuf);  // TODO(bfredl): remove this condition
-  int changed = 0;
   int added = 0;
   int height;
   int width;
@@ -1864,26 +2137,91 @@ static void refresh_screen(Terminal *term, buf_T *buf)
     return;
   }
 
+  row_cache_ensure(term);
+
+  // Rows whose text did not change (e.g. only the cursor moved or attributes
+  // changed) are only redrawn, without touching the memline.
+  int change_start = INT_MAX;
+  int change_end = 0;
+  int redraw_start = INT_MAX;
+  int redraw_end = 0;
   for (int r = term->invalid_start, linenr = row_to_linenr(term, r);
        r < term->invalid_end; r++, linenr++) {
     fetch_row(term, r, width);
+    TermRowCache *rc = &term->cache.row[r];
+    size_t len = strlen(term->textbuf);
+    hash_T hash = hash_hash_len(term->textbuf, len);
 
     if (linenr <= buf->b_ml.ml_line_count) {
+      if (rc->text_valid && rc->text_hash == hash && rc->text_len == len
+          && strcmp(ml_get_buf(buf, linenr), term->textbuf) == 0) {
+        redraw_start = MIN(redraw_start, linenr);
+        redraw_end = MAX(redraw_end, linenr);
+        continue;
+      }
       ml_replace(linenr, term->textbuf, true);
-      changed++;
+      change_start = MIN(change_start, linenr);
+      change_end = MAX(change_end, linenr + 1);
     } else {
       ml_append(linenr - 1, term->textbuf, 0, false);
+      change_start = MIN(change_start, linenr);
+      if (!added) {
+        change_end = linenr;  // appended lines are inserted here
+      }
       added++;
     }
+    *rc = (TermRowCache) {
+      .text_hash = hash, .text_len = len, .text_valid = true, .attrs_valid = rc->attrs_valid
+    };
   }
 
-  int change_start = row_to_linenr(term, term->invalid_start);
-  int change_end = change_start + changed;
-  changed_lines(buf, change_start, 0, change_end, added, true);
+  if (change_start != INT_MAX) {
+    changed_lines(buf, change_start, 0, MAX(change_end, change_start), added, true);
+  }
+  if (redraw_start != INT_MAX) {
+    redraw_buf_range_later(buf, redraw_start, redraw_end);
+  }
   term->invalid_start = INT_MAX;
   term->invalid_end = -1;
 }
 
+/// Makes sure the row cache matches the current terminal size and highlight
+/// tables, discarding it otherwise.
+static void row_cache_ensure(Terminal *term)
+{
+  int height, width;
+  vterm_get_size(term->vt, &height, &width);
+  width = MIN(TERM_ATTRS_MAX, width);
+  if (term->cache.rows != height || term->cache.cols != width) {
+    xfree(term->cache.row);
+    xfree(term->cache.attrs);
+    term->cache.rows = height;
+    term->cache.cols = width;
+    term->cache.row = xcalloc((size_t)height, sizeof(*term->cache.row));
+    term->cache.attrs = xmalloc((size_t)height * (size_t)width * sizeof(int));
+    term->cache.hl_generation = hl_attr_generation;
+  } else if (term->cache.hl_generation != hl_attr_generation) {
+    for (int row = 0; row < term->cache.rows; row++) {
+      term->cache.row[row].attrs_valid = false;
+    }
+    term->cache.hl_generation = hl_attr_generation;
+  }
+}
+
+static void row_cache_invalidate_attrs(Terminal *term, int start_row, int end_row)
+{
+  for (int row = MAX(start_row, 0); row < MIN(end_row, term->cache.rows); row++) {
+    term->cache.row[row].attrs_valid = false;
+  }
+}
+
+static void row_cache_invalidate_text(Terminal *term)
+{
+  for (int row = 0; row < term->cache.rows; row++) {
+    term->cache.row[row].text_valid = false;
+  }
+}
+
 static void adjust_topline(Terminal *term, buf_T *buf, int added)
 {
   FOR_ALL_TAB_WINDOWS(tp, wp) {
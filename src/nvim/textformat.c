@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "klib/kvec.h"
 #include "nvim/ascii_defs.h"
 #include "nvim/buffer_defs.h"
 #include "nvim/change.h"
@@ -14,11 +15,17 @@
 #include "nvim/eval.h"
 #include "nvim/eval/typval_defs.h"
 #include "nvim/ex_cmds_defs.h"
+#include "nvim/extmark.h"
+#include "nvim/extmark_defs.h"
+#include "nvim/garray.h"
+#include "nvim/garray_defs.h"
 #include "nvim/getchar.h"
 #include "nvim/globals.h"
 #include "nvim/indent.h"
 #include "nvim/indent_c.h"
+#include "nvim/macros_defs.h"
 #include "nvim/mark.h"
+#include "nvim/marktree.h"
 #include "nvim/mbyte.h"
 #include "nvim/memline.h"
 #include "nvim/memory.h"
@@ -890,6 +897,252 @@ int fex_format(linenr_T lnum, long count, int c)
   return r;
 }
 
+/// Check that paragraph line "line" can be handled by format_lines_batch():
+/// no TAB after the indent, no trailing white space, no composing character
+/// on a blank and no double-width or illegal character.
+static bool fmt_batch_line_ok(const char *line, colnr_T len)
+{
+  if (len > 0 && ascii_iswhite((uint8_t)line[len - 1])) {
+    return false;
+  }
+  const char *text = skipwhite(line);
+  for (const char *p = line; *p != NUL;) {
+    if (ascii_iswhite((uint8_t)(*p))) {
+      if ((*p == TAB && p >= text) || utf_iscomposing(utf_ptr2char(p + 1))) {
+        return false;
+      }
+      p++;
+    } else {
+      if ((uint8_t)(*p) >= 0x80 && (utf_ptr2len(p) == 1 || utf_ptr2cells(p) != 1)) {
+        return false;
+      }
+      p += utfc_ptr2len(p);
+    }
+  }
+  return true;
+}
+
+/// Check if a named mark of the current buffer is in lines "first" to "last".
+/// format_lines_batch() cannot move those to the line that gets their text.
+static bool fmt_batch_has_marks(linenr_T first, linenr_T last)
+{
+  for (int i = 0; i < NGLOBALMARKS; i++) {
+    if (i < NMARKS && curbuf->b_namedm[i].mark.lnum >= first
+        && curbuf->b_namedm[i].mark.lnum <= last) {
+      return true;
+    }
+    if (namedfm[i].fmark.fnum == curbuf->b_fnum && namedfm[i].fmark.mark.lnum >= first
+        && namedfm[i].fmark.mark.lnum <= last) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Break the joined text of a paragraph into lines that fit in "textwidth" and
+/// append them to "lines".  Like internal_format(), a line is broken at the
+/// last run of blanks that starts at or before "textwidth", or at the first
+/// run when there is no such one.
+///
+/// @param text    NUL-terminated text of the paragraph
+/// @param len     length of "text"
+/// @param indent  indent of the first line, in columns
+static void fmt_batch_break(garray_T *lines, const char *text, size_t len, int indent,
+                            int textwidth)
+{
+  // Same TABs and spaces as set_indent() would use.
+  StringBuilder ind = KV_INITIAL_VALUE;
+  int col = 0;
+  if (!curbuf->b_p_et) {
+    while (indent - col >= tabstop_padding(col, curbuf->b_p_ts, curbuf->b_p_vts_array)) {
+      col += tabstop_padding(col, curbuf->b_p_ts, curbuf->b_p_vts_array);
+      kv_push(ind, TAB);
+    }
+  }
+  for (; col < indent; col++) {
+    kv_push(ind, ' ');
+  }
+
+  const char *s = text;
+  const char *const end = text + len;
+  bool first_line = true;
+  while (true) {
+    // Without 'autoindent' the following lines are not indented.
+    const bool use_indent = first_line || curbuf->b_p_ai;
+    int vcol = use_indent ? indent : 0;
+    const char *found = NULL;  // start of last blank run before the margin
+    const char *brk = NULL;
+    const char *p = s;
+    while (p < end) {
+      if (*p == ' ') {
+        if (vcol > textwidth) {
+          brk = found != NULL ? found : p;
+          break;
+        }
+        found = p;
+        while (p < end && *p == ' ') {
+          p++;
+          vcol++;
+        }
+      } else {
+        vcol += (uint8_t)(*p) < 0x80 ? byte2cells((uint8_t)(*p)) : utf_ptr2cells(p);
+        p += utfc_ptr2len_len(p, (int)(end - p));
+      }
+    }
+    if (brk == NULL && vcol > textwidth) {
+      brk = found;
+    }
+
+    const size_t ind_len = use_indent ? kv_size(ind) : 0;
+    const size_t line_len = (size_t)((brk != NULL ? brk : end) - s);
+    char *line = xmalloc(ind_len + line_len + 1);
+    memcpy(line, ind.items, ind_len);
+    memcpy(line + ind_len, s, line_len);
+    line[ind_len + line_len] = NUL;
+    GA_APPEND(char *, lines, line);
+
+    if (brk == NULL) {
+      break;
+    }
+    s = skipwhite(brk);
+    first_line = false;
+  }
+  kv_destroy(ind);
+}
+
+/// Fast path of format_lines() for a range of plain text paragraphs.
+///
+/// Each paragraph is joined and broken in one pass over its text, and the
+/// range is then replaced at once, instead of joining and splitting lines one
+/// at a time with do_join() and open_line().  The result is the same as with
+/// the generic code.  Nothing is done when the range needs anything that code
+/// handles specially: comment leaders, lists, indent programs, TABs inside the
+/// text, extmarks, named marks.  Other marks in the range (jumplist,
+/// changelist, Visual area) keep their line number, like with ":sort".
+///
+/// @return  true when the lines were formatted, false to use the generic code.
+static bool format_lines_batch(linenr_T line_count)
+{
+  static const char fo_unsupported[] = {
+    FO_Q_SECOND, FO_Q_NUMBER, FO_WHITE_PAR, FO_MBYTE_BREAK, FO_MBYTE_JOIN,
+    FO_MBYTE_JOIN2, FO_ONE_LETTER, FO_PERIOD_ABBR, NUL
+  };
+  for (const char *fo = fo_unsupported; *fo != NUL; fo++) {
+    if (has_format_option((uint8_t)(*fo))) {
+      return false;
+    }
+  }
+  if ((State & VREPLACE_FLAG)
+      || *curbuf->b_p_fex != NUL
+      || curbuf->b_p_lisp || curbuf->b_p_cin || *curbuf->b_p_inde != NUL
+      || curbuf->b_p_si || curbuf->b_p_ci || curbuf->b_p_pi
+      || (curwin->w_p_wrap && (curwin->w_p_bri || *get_showbreak_value(curwin) != NUL))) {
+    return false;
+  }
+  const int textwidth = comp_textwidth(true);
+  if (textwidth <= 0) {
+    return false;
+  }
+
+  const linenr_T first = curwin->w_cursor.lnum;
+  const linenr_T last = MIN(first + line_count - 1, curbuf->b_ml.ml_line_count);
+
+  // Extmarks in the range would all end up at its start.
+  MarkTreeIter itr[1] = { 0 };
+  marktree_itr_get(curbuf->b_marktree, first - 1, 0, itr);
+  MTKey mark = marktree_itr_current(itr);
+  if ((mark.pos.row >= 0 && mark.pos.row <= last - 1) || fmt_batch_has_marks(first, last)) {
+    return false;
+  }
+
+  const bool do_comments = has_format_option(FO_Q_COMS);
+  int leader_len;
+  char *leader_flags = NULL;
+  bcount_t old_bytes = 0;
+  for (linenr_T lnum = first; lnum <= last; lnum++) {
+    const colnr_T len = ml_get_len(lnum);
+    old_bytes += len + 1;
+    if (!fmt_check_par(lnum, &leader_len, &leader_flags, do_comments)
+        && (leader_len > 0 || !fmt_batch_line_ok(ml_get(lnum), len))) {
+      return false;
+    }
+  }
+
+  garray_T lines;
+  ga_init(&lines, (int)sizeof(char *), 100);
+  StringBuilder par = KV_INITIAL_VALUE;
+  linenr_T lnum = first;
+  while (lnum <= last && !got_int) {
+    // Lines that are not part of a paragraph are kept as they are.
+    if (fmt_check_par(lnum, &leader_len, &leader_flags, do_comments)) {
+      GA_APPEND(char *, &lines, xstrdup(ml_get(lnum)));
+      lnum++;
+      continue;
+    }
+
+    // Join the lines of the paragraph the way do_join() does.
+    const int indent = get_indent_lnum(lnum);
+    kv_size(par) = 0;
+    for (; lnum <= last && !fmt_check_par(lnum, &leader_len, &leader_flags, do_comments);
+         lnum++) {
+      char *line = ml_get(lnum);
+      char *text = skipwhite(line);
+      if (kv_size(par) > 0 && *text != ')') {
+        char endc = kv_last(par);
+        kv_push(par, ' ');
+        // Extra space when 'joinspaces' set and line ends in '.', '?', or '!'.
+        if (p_js && (endc == '.' || endc == '?' || endc == '!')) {
+          kv_push(par, ' ');
+        }
+      }
+      kv_concat_len(par, text, (size_t)ml_get_len(lnum) - (size_t)(text - line));
+      line_breakcheck();
+    }
+    kv_push(par, NUL);
+    fmt_batch_break(&lines, par.items, kv_size(par) - 1, indent, textwidth);
+  }
+  kv_destroy(par);
+
+  if (got_int) {
+    ga_clear_strings(&lines);
+    return true;
+  }
+
+  const linenr_T old_count = last - first + 1;
+  const linenr_T new_count = (linenr_T)lines.ga_len;
+  char **new_lines = lines.ga_data;
+  bcount_t new_bytes = 0;
+  linenr_T i;
+  for (i = 0; i < old_count && i < new_count; i++) {
+    new_bytes += (bcount_t)strlen(new_lines[i]) + 1;
+    ml_replace(first + i, new_lines[i], false);
+  }
+  for (; i < new_count; i++) {
+    new_bytes += (bcount_t)strlen(new_lines[i]) + 1;
+    ml_append(first + i - 1, new_lines[i], 0, false);
+    xfree(new_lines[i]);
+  }
+  for (; i < old_count; i++) {
+    ml_delete(first + new_count, false);
+  }
+  ga_clear(&lines);
+
+  // Adjust marks for deleted (or added) lines and prepare for displaying.
+  const linenr_T deleted = old_count - new_count;
+  if (deleted > 0) {
+    mark_adjust(first + new_count, last, MAXLNUM, -deleted, kExtmarkNOOP);
+  } else if (deleted < 0) {
+    mark_adjust(last + 1, MAXLNUM, -deleted, 0, kExtmarkNOOP);
+  }
+  extmark_splice(curbuf, (int)first - 1, 0, (int)old_count, 0, old_bytes,
+                 (int)new_count, 0, new_bytes, kExtmarkUndo);
+  changed_lines(curbuf, first, 0, last + 1, -deleted, true);
+
+  curwin->w_cursor.lnum = first + new_count - 1;
+  curwin->w_cursor.col = 0;
+  return true;
+}
+
 /// @param line_count  number of lines to format, starting at the cursor position.
 ///                    when negative, format until the end of the paragraph.
 ///
@@ -928,6 +1181,11 @@ void format_lines(linenr_T line_count, bool avoid_fex)
   const bool do_number_indent = has_format_option(FO_Q_NUMBER);
   const bool do_trail_white = has_format_option(FO_WHITE_PAR);
 
+  // Plain text paragraphs can be formatted all at once.
+  if (line_count > 0 && !avoid_fex && format_lines_batch(line_count)) {
+    return;
+  }
+
   // Get info about the previous and current line.
   if (curwin->w_cursor.lnum > 1) {
     is_not_par = fmt_check_par(curwin->w_cursor.lnum - 1,
@@ -0,0 +1,128 @@
+// Always-on tracing of the time spent in hot paths.
+//
+// A span is recorded as one fixed-size event in a ring buffer: the start time,
+// the duration, what it was and two numbers that depend on the event.  This
+// costs two calls to os_hrtime() and a few stores, cheap enough to leave on.
+// When Nvim was slow or froze, nvim__trace() gives the last spans in the
+// Chrome trace event format, which can be loaded in chrome://tracing or
+// https://ui.perfetto.dev to see what happened.
+//
+// All trace points run in the main thread, the ring is not locked.
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "klib/kvec.h"
+#include "nvim/api/private/defs.h"
+#include "nvim/ascii_defs.h"
+#include "nvim/autocmd.h"
+#include "nvim/autocmd_defs.h"
+#include "nvim/macros_defs.h"
+#include "nvim/os/os.h"
+#include "nvim/os/time.h"
+#include "nvim/strings.h"
+#include "nvim/trace.h"
+#include "nvim/trace_defs.h"
+
+/// A span of time in the ring.
+typedef struct {
+  uint64_t start;    ///< os_hrtime() at the start
+  uint64_t dur;      ///< duration in nanoseconds
+  int64_t arg[2];    ///< depends on "id"
+  TraceEventId id;
+} TraceEvent;
+
+#define TRACE_RING_SIZE 16384  // must be a power of two
+
+static TraceEvent trace_ring[TRACE_RING_SIZE];
+static size_t trace_count = 0;  ///< number of spans recorded so far
+
+static const char *const trace_names[kTraceCount] = {
+  [kTracePollEvents] = "poll_events",
+  [kTraceUpdateScreen] = "update_screen",
+  [kTraceWinUpdate] = "win_update",
+  [kTraceRpcRequest] = "rpc_request",
+  [kTraceAutocmd] = "autocmd",
+  [kTraceGarbageCollect] = "garbage_collect",
+  [kTraceMfSync] = "mf_sync",
+  [kTraceTsParse] = "ts_parse",
+};
+
+static const char *const trace_arg_names[kTraceCount][2] = {
+  [kTracePollEvents] = { "timeout", "expired" },
+  [kTraceUpdateScreen] = { "type", "" },
+  [kTraceWinUpdate] = { "win", "type" },
+  [kTraceRpcRequest] = { "channel", "request_id" },
+  [kTraceAutocmd] = { "event", "buf" },
+  [kTraceGarbageCollect] = { "testing", "freed" },
+  [kTraceMfSync] = { "flags", "status" },
+  [kTraceTsParse] = { "buf", "incremental" },
+};
+
+#ifdef INCLUDE_GENERATED_DECLARATIONS
+# include "trace.c.generated.h"
+#endif
+
+/// Get the start time of a span, to be passed to trace_end().
+uint64_t trace_begin(void)
+  FUNC_ATTR_WARN_UNUSED_RESULT
+{
+  return os_hrtime();
+}
+
+/// Record a span that started at "start", as returned by trace_begin().
+void trace_end(TraceEventId id, uint64_t start, int64_t arg1, int64_t arg2)
+{
+  TraceEvent *ev = &trace_ring[trace_count++ & (TRACE_RING_SIZE - 1)];
+  ev->start = start;
+  ev->dur = os_hrtime() - start;
+  ev->arg[0] = arg1;
+  ev->arg[1] = arg2;
+  ev->id = id;
+}
+
+/// Format the spans that ended in the last "ms" milliseconds as a Chrome trace
+/// event JSON object.  All the spans in the ring are used when "ms" is zero.
+///
+/// @return  allocated string.
+String trace_dump(int64_t ms)
+{
+  uint64_t now = os_hrtime();
+  uint64_t since = 0;
+  if (ms > 0 && (uint64_t)ms * 1000000 < now) {
+    since = now - (uint64_t)ms * 1000000;
+  }
+  int64_t pid = os_get_pid();
+
+  StringBuilder sb = KV_INITIAL_VALUE;
+  kv_printf(sb, "{\"traceEvents\":[");
+  bool first = true;
+  size_t n = MIN(trace_count, TRACE_RING_SIZE);
+  for (size_t i = trace_count - n; i < trace_count; i++) {
+    TraceEvent *ev = &trace_ring[i & (TRACE_RING_SIZE - 1)];
+    if (ev->start + ev->dur < since) {
+      continue;
+    }
+    const char *name = trace_names[ev->id];
+    const char *detail = "";
+    if (ev->id == kTraceAutocmd) {
+      detail = event_nr2name((event_T)ev->arg[0]);
+    }
+    // Chrome trace timestamps are in microseconds.
+    kv_printf(sb, "%s\n{\"name\":\"%s%s%s\",\"ph\":\"X\",\"pid\":%" PRId64 ",\"tid\":1,"
+              "\"ts\":%" PRIu64 ".%03" PRIu64 ",\"dur\":%" PRIu64 ".%03" PRIu64 ","
+              "\"args\":{\"%s\":%" PRId64,
+              first ? "" : ",", name, *detail ? " " : "", detail, pid,
+              ev->start / 1000, ev->start % 1000, ev->dur / 1000, ev->dur % 1000,
+              trace_arg_names[ev->id][0], ev->arg[0]);
+    if (*trace_arg_names[ev->id][1] != NUL) {
+      kv_printf(sb, ",\"%s\":%" PRId64, trace_arg_names[ev->id][1], ev->arg[1]);
+    }
+    kv_printf(sb, "}}");
+    first = false;
+  }
+  kv_printf(sb, "\n]}");
+  return (String){ .data = sb.items, .size = sb.size };
+}
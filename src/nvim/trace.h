@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stdint.h>  // IWYU pragma: keep
+
+#include "nvim/api/private/defs.h"  // IWYU pragma: keep
+#include "nvim/trace_defs.h"  // IWYU pragma: keep
+
+#ifdef INCLUDE_GENERATED_DECLARATIONS
+# include "trace.h.generated.h"
+#endif
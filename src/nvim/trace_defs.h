@@ -0,0 +1,14 @@
+#pragma once
+
+/// Spans recorded by the tracing ring, see trace.c.
+typedef enum {
+  kTracePollEvents,      ///< loop_poll_events(): timeout, whether it expired
+  kTraceUpdateScreen,    ///< update_screen(): must_redraw type
+  kTraceWinUpdate,       ///< win_update(): window, w_redr_type
+  kTraceRpcRequest,      ///< RPC request or notification: channel, request id
+  kTraceAutocmd,         ///< autocommands for an event: event, buffer
+  kTraceGarbageCollect,  ///< garbage_collect(): testing, whether it freed
+  kTraceMfSync,          ///< mf_sync(): flags, status
+  kTraceTsParse,         ///< treesitter parse: buffer, incremental
+  kTraceCount,
+} TraceEventId;
@@ -116,6 +116,7 @@
 #include "nvim/memline.h"
 #include "nvim/memline_defs.h"
 #include "nvim/memory.h"
+#include "nvim/memory_defs.h"
 #include "nvim/message.h"
 #include "nvim/option.h"
 #include "nvim/option_vars.h"
@@ -574,7 +575,7 @@ int u_savecommon(buf_T *buf, linenr_T top, linenr_T bot, linenr_T newbot, bool r
   }
 
   // add lines in front of entry list
-  uep = xmalloc(sizeof(u_entry_T));
+  uep = pool_alloc(sizeof(u_entry_T));
   CLEAR_POINTER(uep);
 #ifdef U_DEBUG
   uep->ue_magic = UE_MAGIC;
@@ -1082,7 +1083,7 @@ static bool serialize_uep(bufinfo_T *bi, u_entry_T *uep)
 
 static u_entry_T *unserialize_uep(bufinfo_T *bi, bool *error, const char *file_name)
 {
-  u_entry_T *uep = xmalloc(sizeof(u_entry_T));
+  u_entry_T *uep = pool_alloc(sizeof(u_entry_T));
   CLEAR_POINTER(uep);
 #ifdef U_DEBUG
   uep->ue_magic = UE_MAGIC;
@@ -2975,7 +2976,7 @@ static void u_freeentry(u_entry_T *uep, int n)
 #ifdef U_DEBUG
   uep->ue_magic = 0;
 #endif
-  xfree(uep);
+  pool_free(uep, sizeof(u_entry_T));
 }
 
 /// invalidate the undo buffer; called when storage has already been released
@@ -3129,6 +3130,29 @@ bool curbufIsChanged(void)
   return bufIsChanged(curbuf);
 }
 
+/// Add the undo tree of buffer "buf" to "gauge", counting the undo entries.
+void u_mem_usage(buf_T *buf, MemGauge *gauge)
+{
+  u_mem_usage_tree(buf->b_u_oldhead, gauge);
+}
+
+static void u_mem_usage_tree(const u_header_T *first_uhp, MemGauge *gauge)
+{
+  for (const u_header_T *uhp = first_uhp; uhp != NULL; uhp = uhp->uh_prev.ptr) {
+    gauge->bytes += sizeof(u_header_T);
+    for (const u_entry_T *uep = uhp->uh_entry; uep != NULL; uep = uep->ue_next) {
+      gauge->count++;
+      gauge->bytes += sizeof(u_entry_T) + (size_t)uep->ue_size * sizeof(char *);
+      for (linenr_T i = 0; i < uep->ue_size; i++) {
+        gauge->bytes += strlen(uep->ue_array[i]) + 1;
+      }
+    }
+    if (uhp->uh_alt_next.ptr != NULL) {
+      u_mem_usage_tree(uhp->uh_alt_next.ptr, gauge);
+    }
+  }
+}
+
 /// Append the list of undo blocks to a newly allocated list
 ///
 /// For use in undotree(). Recursive.
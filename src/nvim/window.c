@@ -5217,6 +5217,8 @@ void win_free(win_T *wp, tabpage_T *tp)
   }
 
   xfree(wp->w_lines);
+  plines_cache_free(wp);
+  vcol_checkpoint_free(wp);
 
   for (int i = 0; i < wp->w_tagstacklen; i++) {
     xfree(wp->w_tagstack[i].tagname);
@@ -5821,7 +5823,13 @@ static void frame_comp_pos(frame_T *topfrp, int *row, int *col)
       // position changed, redraw
       wp->w_winrow = *row;
       wp->w_wincol = *col;
-      redraw_later(wp, UPD_NOT_VALID);
+      if (wp->w_grid_alloc.chars != NULL) {
+        // The window has its own grid, which stays valid when only the
+        // position changes.  The separators are on the default grid.
+        wp->w_redr_sep = true;
+      } else {
+        redraw_later(wp, UPD_NOT_VALID);
+      }
       wp->w_redr_status = true;
       wp->w_pos_changed = true;
     }
@@ -6766,7 +6774,14 @@ void win_set_inner_size(win_T *wp, bool valid_cursor)
 void win_new_width(win_T *wp, int width)
 {
   // Should we give an error if width < 0?
-  wp->w_width = width < 0 ? 0 : width;
+  if (width < 0) {
+    width = 0;
+  }
+  if (wp->w_width == width) {
+    return;  // nothing to do
+  }
+
+  wp->w_width = width;
   wp->w_pos_changed = true;
   win_set_inner_size(wp, true);
 }
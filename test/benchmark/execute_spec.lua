@@ -0,0 +1,41 @@
+local n = require('test.functional.testnvim')()
+
+local clear = n.clear
+local exec_lua = n.exec_lua
+
+describe('execute() perf', function()
+  before_each(function()
+    clear()
+    exec_lua([[
+      local lines = {}
+      for i = 1, 10000 do
+        lines[i] = ('line %d with some text to make it longer'):format(i)
+      end
+      vim.api.nvim_buf_set_lines(0, 0, -1, true, lines)
+    ]])
+  end)
+
+  local function bench(cmd, count)
+    local ms = exec_lua(
+      [[
+      local cmd, count = ...
+      local start = vim.uv.hrtime()
+      for _ = 1, count do
+        vim.fn.execute(cmd)
+      end
+      return (vim.uv.hrtime() - start) / 1000000
+    ]],
+      cmd,
+      count
+    )
+    print(('\n%14.6f ms - execute(%q) %d times'):format(ms, cmd, count))
+  end
+
+  it('large output', function()
+    bench('%print', 20)
+  end)
+
+  it('small output', function()
+    bench('ls', 10000)
+  end)
+end)
@@ -0,0 +1,65 @@
+local n = require('test.functional.testnvim')()
+
+local clear = n.clear
+local exec_lua = n.exec_lua
+
+describe('glob perf', function()
+  local root = 'Xglob_bench'
+
+  setup(function()
+    clear()
+    exec_lua(
+      [[
+      local root = ...
+      for i = 1, 40 do
+        for j = 1, 10 do
+          local dir = ('%s/d%d/s%d'):format(root, i, j)
+          vim.fn.mkdir(dir, 'p')
+          for k = 1, 10 do
+            for _, ext in ipairs({ 'c', 'h', 'txt' }) do
+              vim.fn.writefile({}, ('%s/f%d.%s'):format(dir, k, ext))
+            end
+          end
+        end
+      end
+    ]],
+      root
+    )
+  end)
+
+  teardown(function()
+    n.rmdir(root)
+  end)
+
+  before_each(function()
+    clear()
+  end)
+
+  local function bench(expr)
+    local ms, count = exec_lua(
+      [[
+      local expr = ...
+      local start = vim.uv.hrtime()
+      local res
+      for _ = 1, 5 do
+        res = vim.fn.eval(expr)
+      end
+      return (vim.uv.hrtime() - start) / 5000000, #res
+    ]],
+      expr
+    )
+    print(('\n%14.6f ms - %s (%d matches)'):format(ms, expr, count))
+  end
+
+  it('glob() with braces', function()
+    bench(("glob('%s/**/*.{c,h}', 0, 1)"):format(root))
+  end)
+
+  it('expand() with braces and quotes', function()
+    bench(("expand('%s/d1/s1/''f1''.{c,h,txt}', 0, 1)"):format(root))
+  end)
+
+  it(':args with braces (non-existing names kept)', function()
+    bench(("[execute('args %s/d1/*/f{1,2,99}.{c,h}'), argv()][1]"):format(root))
+  end)
+end)
@@ -0,0 +1,49 @@
+local n = require('test.functional.testnvim')()
+
+local clear = n.clear
+local exec_lua = n.exec_lua
+
+describe('list perf', function()
+  before_each(function()
+    clear()
+  end)
+
+  local function bench(name, code)
+    if code.setup then
+      n.exec(code.setup)
+    end
+    local ms = exec_lua(
+      [[
+      local expr = ...
+      local start = vim.uv.hrtime()
+      for _ = 1, 20 do
+        vim.fn.execute('call ' .. expr)
+      end
+      return (vim.uv.hrtime() - start) / 1000000
+    ]],
+      code.expr
+    )
+    print(('\n%14.6f ms - %s 20 times'):format(ms, name))
+  end
+
+  it('build and free a large list', function()
+    bench('range(1000000)', { expr = 'range(1000000)' })
+  end)
+
+  it('add and remove items', function()
+    bench('add() and remove() 100000 items', {
+      setup = [[
+        func AddRemove()
+          let l = []
+          for i in range(100000)
+            call add(l, i)
+          endfor
+          while !empty(l)
+            call remove(l, -1)
+          endwhile
+        endfunc
+      ]],
+      expr = 'AddRemove()',
+    })
+  end)
+end)
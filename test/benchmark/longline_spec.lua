@@ -0,0 +1,40 @@
+local n = require('test.functional.testnvim')()
+local Screen = require('test.functional.ui.screen')
+
+local clear = n.clear
+local exec_lua = n.exec_lua
+
+describe('long line perf', function()
+  before_each(function()
+    clear()
+    Screen.new(100, 50):attach()
+    -- A single line of 10 MB with Tabs and multibyte characters.
+    exec_lua([[
+      local seg = 'foo\tbar À Ⱡ 0123456789 '
+      vim.api.nvim_buf_set_lines(0, 0, -1, true, { seg:rep(math.floor(10 * 1024 * 1024 / #seg)) })
+    ]])
+  end)
+
+  local function bench(name, setup)
+    n.command(setup)
+    local ms = exec_lua([[
+      local len = #vim.api.nvim_get_current_line()
+      local start = vim.uv.hrtime()
+      for col = 0, len - 1, math.floor(len / 1000) do
+        vim.api.nvim_win_set_cursor(0, { 1, col })
+        vim.fn.virtcol('.')
+        vim.cmd('redraw')
+      end
+      return (vim.uv.hrtime() - start) / 1000000
+    ]])
+    print(('\n%14.6f ms - move the cursor through a 10 MB line, %s'):format(ms, name))
+  end
+
+  it('with wrap', function()
+    bench('wrap', 'set wrap')
+  end)
+
+  it('with nowrap', function()
+    bench('nowrap', 'set nowrap')
+  end)
+end)
@@ -0,0 +1,48 @@
+local n = require('test.functional.testnvim')()
+local Screen = require('test.functional.ui.screen')
+
+local clear = n.clear
+local exec_lua = n.exec_lua
+
+describe('redraw perf', function()
+  before_each(function()
+    clear()
+    Screen.new(400, 100):attach()
+    exec_lua([[
+      local lines = {}
+      for i = 1, 1000 do
+        lines[i] = ('%d '):format(i) .. ('some text with words '):rep(20)
+      end
+      vim.api.nvim_buf_set_lines(0, 0, -1, true, lines)
+      for _ = 1, 3 do
+        vim.cmd('vsplit')
+      end
+      vim.cmd('redraw')
+    ]])
+  end)
+
+  it('all windows, text unchanged', function()
+    local ms = exec_lua([[
+      local start = vim.uv.hrtime()
+      for _ = 1, 200 do
+        vim.api.nvim__redraw({ valid = false, flush = true })
+      end
+      return (vim.uv.hrtime() - start) / 1000000
+    ]])
+    print(('\n%14.6f ms - redraw 4 windows 200 times'):format(ms))
+  end)
+
+  it('move the cursor within a line with cursorline', function()
+    local ms = exec_lua([[
+      vim.wo.cursorline = true
+      vim.wo.relativenumber = true
+      local start = vim.uv.hrtime()
+      for col = 0, 400 do
+        vim.api.nvim_win_set_cursor(0, { 500, col })
+        vim.cmd('redraw')
+      end
+      return (vim.uv.hrtime() - start) / 1000000
+    ]])
+    print(('\n%14.6f ms - move the cursor 400 times'):format(ms))
+  end)
+end)
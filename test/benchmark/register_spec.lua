@@ -0,0 +1,44 @@
+local n = require('test.functional.testnvim')()
+
+local clear = n.clear
+local exec_lua = n.exec_lua
+
+describe('register perf', function()
+  before_each(function()
+    clear()
+    exec_lua([[
+      local lines = {}
+      for i = 1, 500000 do
+        lines[i] = ('line %d with some text to make it longer'):format(i)
+      end
+      vim.api.nvim_buf_set_lines(0, 0, -1, true, lines)
+    ]])
+  end)
+
+  local function bench(keys)
+    local ms = exec_lua(
+      [[
+      local keys = ...
+      local start = vim.uv.hrtime()
+      vim.cmd('normal! ' .. keys)
+      return (vim.uv.hrtime() - start) / 1000000
+    ]],
+      keys
+    )
+    print(('\n%14.6f ms - normal! %s'):format(ms, keys))
+  end
+
+  it('linewise yank', function()
+    bench('ggyG')
+  end)
+
+  it('linewise put', function()
+    n.command('normal! ggyG')
+    bench('Gp')
+  end)
+
+  it('put over a Visual selection', function()
+    n.command('normal! ggyG')
+    bench('ggVGp')
+  end)
+end)
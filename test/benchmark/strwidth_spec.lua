@@ -0,0 +1,39 @@
+local n = require('test.functional.testnvim')()
+
+local clear = n.clear
+local exec_lua = n.exec_lua
+
+describe('string width perf', function()
+  before_each(function()
+    clear()
+  end)
+
+  local function bench(name, expr)
+    local ms, per_line = exec_lua(
+      [[
+      local expr = ...
+      local lines = {}
+      for i = 1, 100000 do
+        lines[i] = ('  if (curwin->w_cursor.lnum > %d && count != 0) {  // check %d'):format(i, i)
+      end
+      local f = loadstring('local s = ... return ' .. expr)
+      local start = vim.uv.hrtime()
+      for _, s in ipairs(lines) do
+        f(s)
+      end
+      local elapsed = vim.uv.hrtime() - start
+      return elapsed / 1000000, elapsed / #lines
+    ]],
+      expr
+    )
+    print(('\n%14.6f ms (%8.1f ns/line) - %s'):format(ms, per_line, name))
+  end
+
+  it('strdisplaywidth()', function()
+    bench('strdisplaywidth()', 'vim.fn.strdisplaywidth(s)')
+  end)
+
+  it('strwidth()', function()
+    bench('strwidth()', 'vim.fn.strwidth(s)')
+  end)
+end)
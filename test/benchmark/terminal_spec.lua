@@ -0,0 +1,56 @@
+local t = require('test.testutil')
+local n = require('test.functional.testnvim')()
+
+local clear = n.clear
+local exec_lua = n.exec_lua
+
+describe('terminal perf', function()
+  local fname = 'Xterminal_bench.txt'
+
+  setup(function()
+    local lines = {}
+    for i = 1, 200000 do
+      lines[i] = ('%6d \027[3%dm%s\027[0m %s'):format(i, i % 8, ('x'):rep(40), ('y'):rep(i % 60))
+    end
+    t.write_file(fname, table.concat(lines, '\n') .. '\n')
+  end)
+
+  teardown(function()
+    os.remove(fname)
+  end)
+
+  before_each(function()
+    clear()
+  end)
+
+  local function bench(scrollback)
+    local ms = exec_lua(
+      [[
+      local fname, scrollback = ...
+      vim.o.scrollback = scrollback
+      local done = false
+      local start = vim.uv.hrtime()
+      vim.fn.termopen({ 'cat', fname }, {
+        on_exit = function()
+          done = true
+        end,
+      })
+      vim.wait(60000, function()
+        return done
+      end, 1)
+      return (vim.uv.hrtime() - start) / 1000000
+    ]],
+      fname,
+      scrollback
+    )
+    print(('\n%14.6f ms - cat 200000 lines, scrollback=%d'):format(ms, scrollback))
+  end
+
+  it('cat large file, scrollback=1000', function()
+    bench(1000)
+  end)
+
+  it('cat large file, scrollback=100000', function()
+    bench(100000)
+  end)
+end)
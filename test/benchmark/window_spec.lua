@@ -0,0 +1,51 @@
+local n = require('test.functional.testnvim')()
+local Screen = require('test.functional.ui.screen')
+
+local clear = n.clear
+local exec_lua = n.exec_lua
+
+describe('window layout perf', function()
+  local function bench(name, multigrid)
+    clear()
+    local screen = Screen.new(200, 60)
+    screen:attach({ ext_multigrid = multigrid })
+    -- 8 columns of 8 windows each.
+    exec_lua([[
+      vim.api.nvim_buf_set_lines(0, 0, -1, true, vim.split(('text '):rep(1000, '\n'), '\n'))
+      for _ = 1, 7 do
+        vim.cmd('vsplit')
+      end
+      for _, win in ipairs(vim.api.nvim_list_wins()) do
+        vim.api.nvim_set_current_win(win)
+        for _ = 1, 7 do
+          vim.cmd('split')
+        end
+      end
+      vim.cmd('redraw')
+    ]])
+    local ms = exec_lua([[
+      local win = vim.api.nvim_list_wins()[1]
+      local start = vim.uv.hrtime()
+      for i = 1, 500 do
+        vim.api.nvim_win_set_height(win, 2 + i % 4)
+        vim.api.nvim_win_set_width(win, 20 + i % 4)
+        vim.cmd('redraw')
+      end
+      vim.cmd('wincmd =')
+      for i = 1, 100 do
+        vim.o.cmdheight = 1 + i % 2
+        vim.cmd('redraw')
+      end
+      return (vim.uv.hrtime() - start) / 1000000
+    ]])
+    print(('\n%14.6f ms - resize windows in a layout of 64 windows, %s'):format(ms, name))
+  end
+
+  it('single grid', function()
+    bench('single grid', false)
+  end)
+
+  it('multigrid', function()
+    bench('multigrid', true)
+  end)
+end)
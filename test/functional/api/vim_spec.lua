@@ -3012,6 +3012,65 @@ describe('API', function()
     end)
   end)
 
+  describe('nvim__memstats', function()
+    it('reports memory per subsystem and buffer', function()
+      local buf = api.nvim_get_current_buf()
+      api.nvim_buf_set_lines(buf, 0, -1, true, { 'line 1', 'line 2', 'line 3' })
+      local ns = api.nvim_create_namespace('memstats')
+      api.nvim_buf_set_extmark(buf, ns, 0, 0, {})
+      api.nvim_buf_set_extmark(buf, ns, 1, 0, {})
+      command('new')
+
+      local stats = api.nvim__memstats()
+      eq(2, #stats.buffers)
+      local b = stats.buffers[1]
+      eq(buf, b.buf)
+      ok(b.memline.count > 0 and b.memline.bytes > 0)
+      eq(1, b.undo.count)
+      eq(2, b.extmarks.count)
+      eq(2, stats.extmarks.count)
+      ok(stats.memline.bytes >= b.memline.bytes + stats.buffers[2].memline.bytes)
+      ok(stats.rpc.count >= 1)
+      ok(stats.lua.bytes > 0)
+    end)
+  end)
+
+  describe('nvim__trace', function()
+    it('returns recent spans as a Chrome trace', function()
+      Screen.new(40, 5):attach()
+      command('autocmd User Traced let g:traced = 1')
+      command('doautocmd User Traced')
+      command('redraw')
+
+      local trace = vim.json.decode(api.nvim__trace(0))
+      local names = {}
+      for _, ev in ipairs(trace.traceEvents) do
+        eq('X', ev.ph)
+        names[ev.name] = true
+      end
+      ok(names['poll_events'])
+      ok(names['update_screen'])
+      ok(names['rpc_request'])
+      ok(names['autocmd User'])
+
+      eq("Invalid 'ms': out of range", pcall_err(api.nvim__trace, -1))
+    end)
+
+    it('does not record idle zero-timeout polls', function()
+      command('autocmd User Traced let g:traced = 1')
+      command('doautocmd User Traced')
+      -- Many more breakchecks than the ring can hold.
+      command('for i in range(20000) | call getchar(0) | endfor')
+
+      local trace = vim.json.decode(api.nvim__trace(0))
+      local names = {}
+      for _, ev in ipairs(trace.traceEvents) do
+        names[ev.name] = true
+      end
+      ok(names['autocmd User'])
+    end)
+  end)
+
   describe('nvim_create_namespace', function()
     it('works', function()
       eq({}, api.nvim_get_namespaces())
@@ -1184,6 +1184,22 @@ describe('API/win', function()
         api.nvim_win_text_height(0, { start_row = 0, start_vcol = 220, end_row = 2, end_vcol = 42 })
       )
     end)
+
+    it('with long lines that change', function()
+      api.nvim_buf_set_lines(0, 0, -1, true, { ('x'):rep(320), ('y'):rep(200) })
+      eq({ all = 7, fill = 0 }, api.nvim_win_text_height(0, {}))
+      -- same length, different width
+      api.nvim_buf_set_lines(0, 0, 1, true, { ('x'):rep(170) .. ('\t'):rep(150) })
+      eq({ all = 21, fill = 0 }, api.nvim_win_text_height(0, {}))
+      api.nvim_buf_set_lines(0, 0, 1, true, { ('x'):rep(320) })
+      eq({ all = 7, fill = 0 }, api.nvim_win_text_height(0, {}))
+      command('set list listchars=eol:$')
+      eq({ all = 8, fill = 0 }, api.nvim_win_text_height(0, {}))
+      command('set nolist')
+      eq({ all = 7, fill = 0 }, api.nvim_win_text_height(0, {}))
+      command('vsplit | vertical resize 40')
+      eq({ all = 13, fill = 0 }, api.nvim_win_text_height(0, {}))
+    end)
   end)
 
   describe('open_win', function()
@@ -857,6 +857,25 @@ describe('put command', function()
         end, true, ' ')
       end)
     end)
+
+    it('puts the saved register when an on_lines callback changes it', function()
+      command('%delete')
+      fn.setline(1, { 'one', 'two', 'three' })
+      feed('yy')
+      n.exec_lua([[
+        vim.api.nvim_buf_attach(0, false, {
+          on_lines = function()
+            vim.fn.setreg('0', { 'changed' }, 'V')
+          end,
+        })
+      ]])
+      feed('jV"0p')
+      expect([[
+      one
+      one
+      three]])
+      eq('changed\n', fn.getreg('0'))
+    end)
   end)
 
   describe('. register special tests', function()
@@ -0,0 +1,60 @@
+local t = require('test.testutil')
+local n = require('test.functional.testnvim')()
+
+local clear, command, eq, api = n.clear, n.command, t.eq, n.api
+local is_os, skip = t.is_os, t.skip
+
+describe(':range! with noshelltemp', function()
+  before_each(function()
+    clear()
+    command('set noshelltemp')
+  end)
+
+  it('streams large ranges through the filter', function()
+    skip(is_os('win'))
+    local lines = {}
+    for i = 1, 100000 do
+      lines[i] = ('%06d'):format(100001 - i)
+    end
+    api.nvim_buf_set_lines(0, 0, -1, true, lines)
+    command('%!sort')
+    local got = api.nvim_buf_get_lines(0, 0, -1, true)
+    eq(100000, #got)
+    eq('000001', got[1])
+    eq('050000', got[50000])
+    eq('100000', got[100000])
+  end)
+
+  it('keeps surrounding lines and handles output without final NL', function()
+    skip(is_os('win'))
+    api.nvim_buf_set_lines(0, 0, -1, true, { 'before', 'b', 'a', 'after' })
+    command('2,3!sort')
+    eq({ 'before', 'a', 'b', 'after' }, api.nvim_buf_get_lines(0, 0, -1, true))
+    command([[2,3!printf 'x\ny']])
+    eq({ 'before', 'x', 'y', 'after' }, api.nvim_buf_get_lines(0, 0, -1, true))
+  end)
+
+  it("does not add a NL after the last line with 'nofixeol' and 'noeol'", function()
+    skip(is_os('win'))
+    local lines = {}
+    for i = 1, 100000 do
+      lines[i] = ('%06d'):format(i)
+    end
+    api.nvim_buf_set_lines(0, 0, -1, true, lines)
+    command('set nofixeol noeol')
+    -- tee writes its output while the input is still streamed in.
+    command('%!tee Xfilter_noeol')
+    local written = t.read_file('Xfilter_noeol')
+    os.remove('Xfilter_noeol')
+    eq(100000 * 7 - 1, #written)
+    eq('100000', written:sub(-6))
+    eq(100000, api.nvim_buf_line_count(0))
+  end)
+
+  it('passes NUL bytes through', function()
+    skip(is_os('win'))
+    api.nvim_buf_set_lines(0, 0, -1, true, { 'a\0b', 'c' })
+    command('%!cat')
+    eq({ 'a\0b', 'c' }, api.nvim_buf_get_lines(0, 0, -1, true))
+  end)
+end)
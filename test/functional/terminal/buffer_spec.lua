@@ -399,6 +399,26 @@ describe(':terminal buffer', function()
     end)
   end)
 
+  it('does not change buffer lines when only the cursor moves', function()
+    local chan = api.nvim_open_term(0, {})
+    api.nvim_chan_send(chan, 'line1\r\nline2\r\nline3')
+    retry(nil, nil, function()
+      eq({ 'line1', 'line2', 'line3' }, api.nvim_buf_get_lines(0, 0, 3, true))
+    end)
+    local tick = api.nvim_buf_get_var(0, 'changedtick')
+    -- Move the cursor around without changing any text.
+    api.nvim_chan_send(chan, '\027[1;1H\027[3;2H\027[2;4H')
+    api.nvim_chan_send(chan, 'e2')
+    retry(nil, nil, function()
+      eq({ 'line1', 'line2', 'line3' }, api.nvim_buf_get_lines(0, 0, 3, true))
+      eq(tick, api.nvim_buf_get_var(0, 'changedtick'))
+    end)
+    api.nvim_chan_send(chan, 'X')
+    retry(nil, nil, function()
+      eq({ 'line1', 'line2X', 'line3' }, api.nvim_buf_get_lines(0, 0, 3, true))
+    end)
+  end)
+
   it('handles split UTF-8 sequences #16245', function()
     local screen = Screen.new(50, 7)
     screen:attach()
@@ -1262,6 +1262,132 @@ describe('CursorLine and CursorLineNr highlights', function()
   end)
 end)
 
+describe('CursorLine when the cursor moves within the line', function()
+  local screen
+
+  before_each(function()
+    clear()
+    screen = Screen.new(30, 4)
+    screen:set_default_attr_ids({
+      [1] = { bold = true, foreground = Screen.colors.Blue1 }, -- NonText
+      [2] = { background = Screen.colors.Grey90 }, -- CursorLine
+      [3] = { background = Screen.colors.Yellow }, -- Search
+      [4] = { foreground = Screen.colors.White, background = Screen.colors.Black }, -- CurSearch
+      [5] = { foreground = Screen.colors.Red, background = Screen.colors.Grey90 }, -- Mark
+      [6] = { foreground = Screen.colors.Black, background = Screen.colors.LightGrey }, -- Visual
+      [7] = { bold = true }, -- ModeMsg
+    })
+    screen:attach()
+    command('set cursorline')
+    command('highlight Mark guifg=Red')
+    api.nvim_buf_set_lines(0, 0, -1, true, { 'foo bar foo', 'two' })
+    screen:expect([[
+      {2:^foo bar foo                   }|
+      two                           |
+      {1:~                             }|
+                                    |
+    ]])
+  end)
+
+  it('updates CurSearch', function()
+    command('set hlsearch')
+    command('highlight CurSearch guibg=Black guifg=White')
+    command('let @/ = "foo"')
+    screen:expect([[
+      {4:^foo}{2: bar }{3:foo}{2:                   }|
+      two                           |
+      {1:~                             }|
+                                    |
+    ]])
+    feed('w')
+    screen:expect([[
+      {3:foo}{2: ^bar }{3:foo}{2:                   }|
+      two                           |
+      {1:~                             }|
+                                    |
+    ]])
+    feed('w')
+    screen:expect([[
+      {3:foo}{2: bar }{4:^foo}{2:                   }|
+      two                           |
+      {1:~                             }|
+                                    |
+    ]])
+  end)
+
+  it('updates matchaddpos() highlights', function()
+    feed('w')
+    screen:expect([[
+      {2:foo ^bar foo                   }|
+      two                           |
+      {1:~                             }|
+                                    |
+    ]])
+    local id = fn.matchaddpos('Mark', { { 1, 5, 3 } })
+    screen:expect([[
+      {2:foo }{5:^bar}{2: foo                   }|
+      two                           |
+      {1:~                             }|
+                                    |
+    ]])
+    feed('w')
+    fn.matchdelete(id)
+    screen:expect([[
+      {2:foo bar ^foo                   }|
+      two                           |
+      {1:~                             }|
+                                    |
+    ]])
+  end)
+
+  it('removes the Visual highlight', function()
+    feed('wvl')
+    screen:expect([[
+      {2:foo }{6:b^a}{2:r foo                   }|
+      two                           |
+      {1:~                             }|
+      {7:-- VISUAL --}                  |
+    ]])
+    feed('<Esc>')
+    screen:expect([[
+      {2:foo b^ar foo                   }|
+      two                           |
+      {1:~                             }|
+                                    |
+    ]])
+  end)
+
+  it('updates decorations of a provider added after it was drawn', function()
+    exec_lua([[
+      local ns = vim.api.nvim_create_namespace('')
+      vim.api.nvim_set_decoration_provider(ns, {
+        on_win = function(_, win, buf)
+          local cursor = vim.api.nvim_win_get_cursor(win)
+          vim.api.nvim_buf_set_extmark(buf, ns, cursor[1] - 1, cursor[2], {
+            end_col = cursor[2] + 1,
+            hl_group = 'Mark',
+            ephemeral = true,
+          })
+        end,
+      })
+    ]])
+    api.nvim_win_set_cursor(0, { 1, 4 })
+    screen:expect([[
+      {2:foo }{5:^b}{2:ar foo                   }|
+      two                           |
+      {1:~                             }|
+                                    |
+    ]])
+    api.nvim_win_set_cursor(0, { 1, 8 })
+    screen:expect([[
+      {2:foo bar }{5:^f}{2:oo                   }|
+      two                           |
+      {1:~                             }|
+                                    |
+    ]])
+  end)
+end)
+
 describe('CursorColumn highlight', function()
   local screen
   before_each(function()
@@ -589,4 +589,74 @@ describe('ext_hlstate detailed highlights', function()
       timeout = 100000,
     }
   end)
+
+  it('rebuilds a large attribute table once and redefines what is drawn', function()
+    insert([[
+      some text
+      more text]])
+    api.nvim_buf_add_highlight(0, -1, 'String', 0, 0, 4)
+    local buf = api.nvim_create_buf(false, true)
+    api.nvim_buf_set_lines(buf, 0, -1, true, { 'float' })
+    local win = api.nvim_open_win(buf, false, {
+      relative = 'editor',
+      row = 0,
+      col = 2,
+      width = 8,
+      height = 2,
+    })
+    api.nvim_set_option_value('winblend', 30, { win = win })
+    -- A namespace highlight keeps its attributes after the rebuild.
+    local ns = api.nvim_create_namespace('compact')
+    api.nvim_set_hl(ns, 'NormalFloat', { fg = 0x123456, bg = 0xfedcba, italic = true })
+    api.nvim_win_set_hl_ns(win, ns)
+    screen:expect({ any = 'float' })
+    local snapshot = screen:get_snapshot()
+
+    local clears = 0
+    local defined = {}
+    local orig_handle_grid_clear = screen._handle_grid_clear
+    function screen._handle_grid_clear(self, grid)
+      clears = clears + 1
+      defined = {}
+      orig_handle_grid_clear(self, grid)
+    end
+    local orig_handle_hl_attr_define = screen._handle_hl_attr_define
+    function screen._handle_hl_attr_define(self, id, ...)
+      defined[id] = true
+      orig_handle_hl_attr_define(self, id, ...)
+    end
+
+    -- More than a quarter of the 65535 possible attributes.
+    n.exec_lua([[
+      for i = 1, 20000 do
+        vim.api.nvim_set_hl(0, 'Many' .. i, { fg = i })
+      end
+    ]])
+    screen:expect(snapshot)
+    t.eq(1, clears)
+    t.eq(
+      { fg = 0x123456, bg = 0xfedcba, italic = true },
+      api.nvim_get_hl(ns, { name = 'NormalFloat' })
+    )
+    -- Every attribute on the screen was defined again after the clear.
+    for _, row in ipairs(screen._grids[1].rows) do
+      for _, cell in ipairs(row) do
+        t.eq(true, cell.hl_id == 0 or defined[cell.hl_id] == true)
+      end
+    end
+
+    -- The groups are all still used, the table is not rebuilt again until
+    -- it has doubled.
+    clears = 0
+    n.feed('k')
+    n.exec_lua([[
+      for i = 20001, 20100 do
+        vim.api.nvim_set_hl(0, 'Many' .. i, { fg = i })
+      end
+    ]])
+    command('redraw')
+    n.feed('j')
+    screen:expect(snapshot)
+    t.eq(0, clears)
+  end)
 end)
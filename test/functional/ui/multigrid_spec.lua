@@ -133,6 +133,94 @@ describe('ext_multigrid', function()
     end}
   end)
 
+  it('moves a window without redrawing its grid', function()
+    command('set laststatus=3')
+    insert('moving')
+    command('vsplit | split | split')
+    command('resize 3 | wincmd j | resize 3 | setlocal winfixheight | wincmd k')
+    screen:expect{grid=[[
+    ## grid 1
+      [6:--------------------------]│[2:--------------------------]|*3
+      ──────────────────────────┤[2:--------------------------]|
+      [5:--------------------------]│[2:--------------------------]|*3
+      ──────────────────────────┤[2:--------------------------]|
+      [4:--------------------------]│[2:--------------------------]|*4
+      {11:[No Name] [+]                                        }|
+      [3:-----------------------------------------------------]|
+    ## grid 2
+      moving                    |
+      {1:~                         }|*11
+    ## grid 3
+                                                           |
+    ## grid 4
+      moving                    |
+      {1:~                         }|*3
+    ## grid 5
+      moving                    |
+      {1:~                         }|*2
+    ## grid 6
+      movin^g                    |
+      {1:~                         }|*2
+    ]]}
+
+    -- XXX: hack to get notifications. Could use next_msg() also.
+    local orig_handle_win_pos = screen._handle_win_pos
+    local orig_handle_grid_line = screen._handle_grid_line
+    local orig_handle_grid_clear = screen._handle_grid_clear
+    local win_pos, grid_lines = {}, {}
+    function screen._handle_win_pos(self, grid, win, startrow, startcol, width, height)
+      win_pos[grid] = {startrow, startcol, width, height}
+      orig_handle_win_pos(self, grid, win, startrow, startcol, width, height)
+    end
+    function screen._handle_grid_line(self, grid, row, col, items)
+      grid_lines[grid] = (grid_lines[grid] or 0) + 1
+      orig_handle_grid_line(self, grid, row, col, items)
+    end
+    function screen._handle_grid_clear(self, grid)
+      grid_lines[grid] = (grid_lines[grid] or 0) + 1
+      orig_handle_grid_clear(self, grid)
+    end
+
+    -- The top window grows and the 'winfixheight' window below it only moves:
+    -- its separators and their connectors are drawn at the new position.
+    command('resize +2')
+    screen:expect{grid=[[
+    ## grid 1
+      [6:--------------------------]│[2:--------------------------]|*5
+      ──────────────────────────┤[2:--------------------------]|
+      [5:--------------------------]│[2:--------------------------]|*3
+      ──────────────────────────┤[2:--------------------------]|
+      [4:--------------------------]│[2:--------------------------]|*2
+      {11:[No Name] [+]                                        }|
+      [3:-----------------------------------------------------]|
+    ## grid 2
+      moving                    |
+      {1:~                         }|*11
+    ## grid 3
+                                                           |
+    ## grid 4
+      moving                    |
+      {1:~                         }|
+    ## grid 5
+      moving                    |
+      {1:~                         }|*2
+    ## grid 6
+      movin^g                    |
+      {1:~                         }|*4
+    ]], condition=function()
+      eq({
+        [2] = { win = 1000, startrow =  0, startcol = 27, width = 26, height = 12 },
+        [4] = { win = 1001, startrow = 10, startcol =  0, width = 26, height =  2 },
+        [5] = { win = 1002, startrow =  6, startcol =  0, width = 26, height =  3 },
+        [6] = { win = 1003, startrow =  0, startcol =  0, width = 26, height =  5 }
+      }, screen.win_position)
+    end}
+    eq({6, 0, 26, 3}, win_pos[5])
+    -- The moved grid keeps its contents and is not redrawn.
+    eq(nil, grid_lines[5])
+    eq(nil, grid_lines[2])
+  end)
+
   describe('split', function ()
     describe('horizontally', function ()
       it('allocates grids', function ()
@@ -890,6 +890,49 @@ describe('statuscolumn', function()
     eq(2, eval('g:stcnr'))
   end)
 
+  it('looks the same on wrapped and filler rows when built once for them', function()
+    screen:try_resize(60, 10)
+    exec([[
+      call setline(1, ['one', repeat('x', 60), 'two', repeat('y', 60)])
+      5,$delete _
+      sign define s1 text=>> texthl=WarningMsg
+      sign place 1 line=2 name=s1 buffer=1
+      set signcolumn=yes cursorline
+      diffthis
+      leftabove vnew
+      call setline(1, ['one', repeat('y', 60)])
+      exe 'sign place 2 line=2 name=s1 buffer=' .. bufnr()
+      diffthis
+      windo set stc=%C%s%l│\ 
+      norm! G
+    ]])
+    screen:expect({ any = vim.pesc('>>') })
+    -- Signs are only drawn on the first row of a line.
+    local snapshot = screen:get_snapshot()
+    eq(2, select(2, snapshot.grid:gsub('>>', '')))
+    -- With an expression the string is built for every row.
+    command([[windo set stc=%C%s%l│%{''}\ ]])
+    screen:expect(snapshot)
+  end)
+
+  it('builds wrapped rows of a fold start apart from its filler rows', function()
+    screen:try_resize(40, 8)
+    exec([[
+      call setline(1, ['one', repeat('x', 60), 'two', 'three'])
+      5,$delete _
+      set foldcolumn=1 stc=%C%l│
+      2,3fold
+      %foldopen
+    ]])
+    local ns = api.nvim_create_namespace('')
+    api.nvim_buf_set_extmark(0, ns, 1, 0, { virt_lines = { { { 'virt' } } }, virt_lines_above = true })
+    screen:expect({ any = 'virt' })
+    local snapshot = screen:get_snapshot()
+    -- With an expression the string is built for every row.
+    command([[set stc=%C%l│%{''}]])
+    screen:expect(snapshot)
+  end)
+
   it('does not wrap multibyte characters at the end of a line', function()
     screen:try_resize(33, 4)
     screen:set_default_attr_ids {
@@ -799,3 +799,129 @@ it('keymap is shown with vertical splits #27269', function()
                                                          |
   ]])
 end)
+
+describe('custom statusline', function()
+  local screen
+  local status_redraws
+
+  before_each(function()
+    clear()
+    screen = Screen.new(40, 5)
+    screen:set_default_attr_ids {
+      [1] = { bold = true, foreground = Screen.colors.Blue }, -- NonText
+      [2] = { bold = true, reverse = true }, -- StatusLine
+    }
+    screen:attach()
+    command('set laststatus=2 redrawdebug+=nodelta')
+    api.nvim_buf_set_lines(0, 0, -1, true, { 'one two', 'three' })
+    status_redraws = 0
+    local orig_handle_grid_line = screen._handle_grid_line
+    function screen._handle_grid_line(self, grid, row, col, items)
+      if row == 3 then
+        status_redraws = status_redraws + 1
+      end
+      orig_handle_grid_line(self, grid, row, col, items)
+    end
+  end)
+
+  it('is not redrawn on cursor movement without cursor items', function()
+    command([[set statusline=%f\ %m]])
+    screen:expect([[
+      ^one two                                 |
+      three                                   |
+      {1:~                                       }|
+      {2:[No Name] [+]                           }|
+                                              |
+    ]])
+    status_redraws = 0
+    feed('w')
+    screen:expect([[
+      one ^two                                 |
+      three                                   |
+      {1:~                                       }|
+      {2:[No Name] [+]                           }|
+                                              |
+    ]])
+    feed('j')
+    screen:expect([[
+      one two                                 |
+      thr^ee                                   |
+      {1:~                                       }|
+      {2:[No Name] [+]                           }|
+                                              |
+    ]])
+    eq(0, status_redraws)
+    -- Still redrawn when what it shows changes.
+    feed('x')
+    screen:expect([[
+      one two                                 |
+      thr^e                                    |
+      {1:~                                       }|
+      {2:[No Name] [+]                           }|
+                                              |
+    ]])
+    command('set nomodified')
+    screen:expect([[
+      one two                                 |
+      thr^e                                    |
+      {1:~                                       }|
+      {2:[No Name]                               }|
+                                              |
+    ]])
+  end)
+
+  it('is redrawn on cursor movement with cursor items', function()
+    command([[set statusline=%f\ %m%=%l,%c]])
+    screen:expect([[
+      ^one two                                 |
+      three                                   |
+      {1:~                                       }|
+      {2:[No Name] [+]                        1,1}|
+                                              |
+    ]])
+    feed('w')
+    screen:expect([[
+      one ^two                                 |
+      three                                   |
+      {1:~                                       }|
+      {2:[No Name] [+]                        1,5}|
+                                              |
+    ]])
+    feed('j')
+    screen:expect([[
+      one two                                 |
+      thr^ee                                   |
+      {1:~                                       }|
+      {2:[No Name] [+]                        2,4}|
+                                              |
+    ]])
+  end)
+
+  it('is redrawn on cursor movement with an expression', function()
+    command([[set statusline=%!'line\ '.line('.')]])
+    screen:expect([[
+      ^one two                                 |
+      three                                   |
+      {1:~                                       }|
+      {2:line 1                                  }|
+                                              |
+    ]])
+    feed('j')
+    screen:expect([[
+      one two                                 |
+      ^three                                   |
+      {1:~                                       }|
+      {2:line 2                                  }|
+                                              |
+    ]])
+    command([[set statusline=%{col('.')}]])
+    feed('l')
+    screen:expect([[
+      one two                                 |
+      t^hree                                   |
+      {1:~                                       }|
+      {2:2                                       }|
+                                              |
+    ]])
+  end)
+end)
@@ -23,3 +23,37 @@ describe('extend()', function()
     eq({ 1, 1, {}, {} }, api.nvim_get_var('l'))
   end)
 end)
+
+describe('deepcopy()', function()
+  -- Live objects in the small object pools, see pool_alloc().
+  local function pool_live()
+    local live = 0
+    for _, pool in ipairs(api.nvim__stats().pools) do
+      live = live + pool.live
+    end
+    return live
+  end
+
+  it('gives back list items when the nesting is too deep', function()
+    n.exec([[
+      let deep = []
+      let l = deep
+      for i in range(102)
+        let l2 = [i]
+        call add(l, l2)
+        let l = l2
+      endfor
+      unlet l l2
+    ]])
+    local before = pool_live()
+    for _ = 1, 10 do
+      eq(
+        'Vim(let):E698: Variable nested too deep for making a copy',
+        t.pcall_err(n.command, 'let m = deepcopy(deep)')
+      )
+    end
+    n.command('call garbagecollect(1)')
+    eq(before, pool_live())
+    n.assert_alive()
+  end)
+end)
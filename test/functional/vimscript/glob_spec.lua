@@ -27,4 +27,35 @@ describe('glob()', function()
     -- Do it again to verify scandir_next_with_dots() internal state.
     eq({}, eval("glob('*', 0, 1)"))
   end)
+  it('matches braces as one pattern', function()
+    local files = { 'a.c', 'a.h', 'ab.c', 'b.c', 'b.h', 'b1.c' }
+    for _, f in ipairs(files) do
+      command(("call writefile([], '%s')"):format(f))
+    end
+    finally(function()
+      for _, f in ipairs(files) do
+        command(("call delete('%s')"):format(f))
+      end
+    end)
+    -- One sorted list, not sorted per alternative.
+    eq({ 'a.c', 'a.h', 'ab.c', 'b.c', 'b.h', 'b1.c' }, eval("glob('*.{c,h}', 0, 1)"))
+    -- Overlapping alternatives do not give duplicates.
+    eq({ 'a.c', 'a.h', 'ab.c' }, eval("glob('{a*,ab*}', 0, 1)"))
+    -- No integer sequences.
+    eq({}, eval("glob('b{1..2}.c', 0, 1)"))
+  end)
+end)
+
+describe('wildcard expansion', function()
+  it('expands braces and quotes without a shell', function()
+    t.skip(t.is_os('win'))
+    command('set shell=doesnotexist')
+    command('args X{a,b}.{c,h} Y{1..3} Z{x,{y,z}w}')
+    eq(
+      { 'Xa.c', 'Xa.h', 'Xb.c', 'Xb.h', 'Y1', 'Y2', 'Y3', 'Zx', 'Zyw', 'Zzw' },
+      eval('argv()')
+    )
+    command([[args 'X*.{c}' X\{a,b} {}]])
+    eq({ 'X*.{c}', 'X{a,b}', '{}' }, eval('argv()'))
+  end)
 end)
@@ -127,6 +127,37 @@ describe('system()', function()
     end
   end)
 
+  it('runs a simple command without starting the shell', function()
+    t.skip(is_os('win'), 'N/A for Windows')
+    command('set shell=sh shellcmdflag=-c shellquote= shellxquote=')
+    local before = api.nvim__stats()
+    eq('3\n', eval([[system('expr 1 + 2')]]))
+    local after = api.nvim__stats()
+    eq(before.spawn + 1, after.spawn)
+    eq(before.spawn_direct + 1, after.spawn_direct)
+    t.ok(after.spawn_time > before.spawn_time)
+    -- Pipes, quotes, variables and builtins still go through the shell.
+    eq('hi\n', eval([[system('expr hi | cat')]]))
+    eq('a b\n', eval([[system("expr 'a b'")]]))
+    eq('/\n', eval([[system('cd / && pwd')]]))
+    eq('hi there\n', eval([[system('echo hi there')]]))
+    eq('hi', eval([[system('printf hi')]]))
+    eq('', eval([[system('true')]]))
+    eq(after.spawn_direct, api.nvim__stats().spawn_direct)
+    eq(after.spawn + 6, api.nvim__stats().spawn)
+    -- A script without "#!" cannot be executed directly, the shell runs it.
+    t.write_file('Xscript', 'echo from script\n')
+    call('setfperm', 'Xscript', 'rwx------')
+    eq('from script\n', eval([[system('./Xscript')]]))
+    eq(0, eval('v:shell_error'))
+    os.remove('Xscript')
+    eq(after.spawn_direct, api.nvim__stats().spawn_direct)
+    -- Only with the default 'shellcmdflag'.
+    command('set shellcmdflag=-ec')
+    eq('3\n', eval([[system('expr 1 + 2')]]))
+    eq(after.spawn_direct, api.nvim__stats().spawn_direct)
+  end)
+
   describe('executes shell function', function()
     local screen
 
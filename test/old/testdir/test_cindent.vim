@@ -5448,5 +5448,56 @@ func Test_find_brace_backwards()
   bwipe!
 endfunc
 
+" Reindenting a range must give the same result as reindenting each line by
+" itself, also when braces are in strings, comments and continued lines.
+func Test_cindent_range_same_as_lines()
+  new
+  setlocal cindent sw=4 sts=4 et
+  let code =<< trim [CODE]
+    namespace ns {
+    class A {
+    public:
+    int f(int x) {
+    if (x) {
+    return g("}", '{', x);
+    } else {
+    /* { */
+    // }
+    while (x--) {
+    x += 1;
+    }
+    }
+    #define M(a) \
+    { a; "}" \
+    }
+    const char *s = "{\"}";
+    for (int i = 0; i < x; i++)
+    h(i,
+    "{");
+    return R"({)";
+    }
+    };
+    }
+    void k(void)
+    {
+    {
+    int y = 1;
+    }
+    }
+  [CODE]
+  call setline(1, code)
+
+  normal! gg=G
+  let expected = getline(1, '$')
+
+  call setline(1, code)
+  for lnum in range(1, line('$'))
+    exe lnum .. 'normal! =='
+  endfor
+  call assert_equal(expected, getline(1, '$'))
+
+  bwipe!
+endfunc
+
 
 " vim: shiftwidth=2 sts=2 expandtab
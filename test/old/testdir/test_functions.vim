@@ -3584,6 +3584,54 @@ func Test_virtcol()
   bwipe!
 endfunc
 
+" Test for virtcol() in a long line, before and after changing it
+func Test_virtcol_long_line()
+  new
+  let seg = "ab\tcd\u20ac\u0301 "
+  call setline(1, repeat(seg, 5000))
+
+  func s:CheckVirtcol(cols)
+    let line = getline(1)
+    for col in a:cols
+      let vcol = strdisplaywidth(strpart(line, 0, col - 1)) + 1
+      call assert_equal(vcol, virtcol([1, col], v:true)[0], 'col ' .. col)
+    endfor
+  endfunc
+
+  let cols = range(1, 5000 * 11, 1237)->map({_, v -> v - (v - 1) % 11})
+  call s:CheckVirtcol(cols)
+  call s:CheckVirtcol(reverse(copy(cols)))
+
+  " Insert a Tab in the middle, the text after it moves
+  call cursor(1, 25000 * 11 / 10 + 1)
+  exe "normal! i\t"
+  call s:CheckVirtcol(cols)
+  normal! x
+  call s:CheckVirtcol(cols)
+
+  setlocal tabstop=4
+  call s:CheckVirtcol(cols)
+  call setline(1, "\t" .. getline(1))
+  call s:CheckVirtcol(cols)
+
+  " Change the line while the buffer is hidden
+  let bnr = bufnr()
+  setlocal bufhidden=hide
+  enew
+  call setbufline(bnr, 1, "  " .. getbufline(bnr, 1)[0])
+  exe 'buffer' bnr
+  bwipe #
+  call s:CheckVirtcol(cols)
+  enew
+  call setbufline(bnr, 1, repeat(seg, 2500))
+  exe 'buffer' bnr
+  bwipe #
+  call s:CheckVirtcol(cols[: len(cols) / 2 - 1])
+
+  delfunc s:CheckVirtcol
+  bwipe!
+endfunc
+
 func Test_delfunc_while_listing()
   CheckRunVimInTerminal
 
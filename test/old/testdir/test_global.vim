@@ -128,4 +128,24 @@ func Test_interrupt_global()
   call delete('Xtest_interrupt_global')
 endfunc
 
+" Test for deleting runs of matching lines into the black hole register
+func Test_global_delete_blackhole()
+  new
+  call setline(1, ['a', '', '', 'b', '', 'c', '', '', ''])
+  let @" = 'keep'
+  g/^$/d _
+  call assert_equal(['a', 'b', 'c'], getline(1, '$'))
+  call assert_equal('keep', @")
+  call assert_equal(3, line('.'))
+  undo
+  call assert_equal(['a', '', '', 'b', '', 'c', '', '', ''], getline(1, '$'))
+  v/^$/:delete _
+  call assert_equal(['', '', '', '', '', ''], getline(1, '$'))
+  %delete _
+  call setline(1, ['x', 'x', 'y', 'x'])
+  g/x/d_
+  call assert_equal(['y'], getline(1, '$'))
+  bwipe!
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
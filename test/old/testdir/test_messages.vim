@@ -39,6 +39,33 @@ func Test_messages()
   call assert_fails('message 1', 'E474:')
 endfunc
 
+" The oldest messages are dropped when the history is full.
+func Test_messages_history_full()
+  let oldmore = &more
+  try
+    set nomore
+    messages clear
+    for i in range(500)
+      echomsg 'msg' .. i
+    endfor
+    let msg_list = GetMessages()
+    call assert_equal(201, len(msg_list))
+    call assert_equal('msg299', msg_list[0])
+    call assert_equal('msg499', msg_list[-1])
+
+    redir => result
+    3messages
+    redir END
+    call assert_equal(['msg497', 'msg498', 'msg499'], split(result, "\n"))
+
+    10messages clear
+    call assert_equal(map(range(490, 499), '"msg" .. v:val'), GetMessages())
+    messages clear
+  finally
+    let &more = oldmore
+  endtry
+endfunc
+
  " Patch 7.4.1696 defined the "clearmode()" command for clearing the mode
 " indicator (e.g., "-- INSERT --") when ":stopinsert" is invoked.  Message
 " output could then be disturbed when 'cmdheight' was greater than one.
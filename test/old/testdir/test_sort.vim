@@ -1520,4 +1520,23 @@ func Test_sort_with_marks()
   close!
 endfunc
 
+" Test for sorting lines that differ only after their first eight bytes
+func Test_sort_long_common_prefix()
+  new
+  call setline(1, ['abcdefghj', 'abcdefgh', 'ABCDEFGHI', 'abcdefg', 'abcdefghi', ''])
+  sort
+  call assert_equal(['', 'ABCDEFGHI', 'abcdefg', 'abcdefgh', 'abcdefghi', 'abcdefghj'],
+        \ getline(1, '$'))
+  sort i
+  call assert_equal(['', 'abcdefg', 'abcdefgh', 'ABCDEFGHI', 'abcdefghi', 'abcdefghj'],
+        \ getline(1, '$'))
+  sort iu
+  call assert_equal(['', 'abcdefg', 'abcdefgh', 'ABCDEFGHI', 'abcdefghj'], getline(1, '$'))
+  %delete
+  call setline(1, ['x 12345678b', 'y 12345678a', 'z 1234567'])
+  sort /^. /
+  call assert_equal(['z 1234567', 'y 12345678a', 'x 12345678b'], getline(1, '$'))
+  close!
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
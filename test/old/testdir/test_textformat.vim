@@ -1304,4 +1304,76 @@ func Test_correct_cursor_position()
   set encoding=utf8
 endfunc
 
+" Formatting plain text paragraphs must give the same result as formatting
+" them one line at a time, which is what happens when 'formatexpr' falls back
+" to internal formatting.
+func Test_format_paragraphs_batch()
+  func FallBack()
+    return 1
+  endfunc
+
+  let text = ["    Lorem ipsum dolor sit amet, consectetur adipiscing elit.",
+        \ "Sed do eiusmod tempor incididunt ut labore et dolore magna.",
+        \ "  (aliqua) Ut enim ad minim veniam,",
+        \ ")quis nostrud exercitation ullamco laboris nisi ut aliquip!",
+        \ "",
+        \ "averyveryverylongwordthatcannotbebrokenanywhereatall and more",
+        \ "\tex ea commodo  consequat.   Duis aute irure dolor in",
+        \ "reprehenderit in voluptate velit esse cillum dolore",
+        \ "   ",
+        \ "\t\tshort one"]
+  let text += map(range(200), {i, _ -> 'word' .. i .. ' text, ' .. repeat('x', i % 13 + 1)})
+
+  new
+  for opts in ['ai noet ts=8', 'noai noet ts=4', 'ai et ts=8', 'ai noet vts=3,5']
+    exe 'setlocal tw=30 fo=tcq nojoinspaces ' .. opts
+    for js in [0, 1]
+      let &joinspaces = js
+      setlocal formatexpr=
+      %delete _
+      call setline(1, text)
+      normal gggqG
+      let expected = getline(1, '$')
+      let expected_lnum = line('.')
+
+      setlocal formatexpr=FallBack()
+      %delete _
+      call setline(1, text)
+      normal gggqG
+      call assert_equal(expected, getline(1, '$'), opts)
+      call assert_equal(expected_lnum, line('.'), opts)
+    endfor
+  endfor
+
+  bwipe!
+  set joinspaces&
+  delfunc FallBack
+endfunc
+
+" Named marks in formatted paragraphs stay on their text.
+func Test_format_paragraphs_marks()
+  new
+  setlocal tw=20 fo=tcq
+  call setline(1, ['one two three four five six', 'seven eight', 'nine ten',
+        \ '', 'eleven twelve'])
+  call setpos("'a", [0, 2, 7, 0])
+  call setpos("'b", [0, 3, 1, 0])
+  call setpos("'c", [0, 5, 8, 0])
+  normal gggqG
+  call assert_equal(['one two three four', 'five six seven eight', 'nine ten',
+        \ '', 'eleven twelve'], getline(1, '$'))
+  call assert_equal([0, 2, 16, 0], getpos("'a"))
+  call assert_equal([0, 3, 1, 0], getpos("'b"))
+  call assert_equal([0, 5, 8, 0], getpos("'c"))
+
+  " Also when lines are removed.
+  %delete _
+  call setline(1, ['alpha', 'beta', 'gamma', 'delta'])
+  call setpos("'a", [0, 4, 1, 0])
+  normal gggqG
+  call assert_equal(['alpha beta gamma', 'delta'], getline(1, '$'))
+  call assert_equal([0, 2, 1, 0], getpos("'a"))
+  bwipe!
+endfunc
+
 " vim: shiftwidth=2 sts=2 expandtab
@@ -186,6 +186,14 @@ func Test_setcellwidths()
   call assert_equal(2, strwidth("\u1339"))
   call assert_equal(1, strwidth("\u133a"))
 
+  " a range spanning several blocks of 256 characters
+  call assert_equal(2, strwidth("\u4e00"))
+  call setcellwidths([[0x4dff, 0x4f00, 1]])
+  call assert_equal(1, strwidth("\u4e00"))
+  call assert_equal(1, strwidth("\u4f00"))
+  call assert_equal(2, strwidth("\u4f01"))
+  call assert_equal(2, strwidth("\u5000"))
+
   for aw in ['single', 'double']
     exe 'set ambiwidth=' . aw
     " Handle \u0080 to \u009F as control chars even on MS-Windows.
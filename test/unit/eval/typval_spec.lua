@@ -48,7 +48,8 @@ local lib = cimport(
   './src/nvim/garray.h',
   './src/nvim/eval.h',
   './src/nvim/vim_defs.h',
-  './src/nvim/globals.h'
+  './src/nvim/globals.h',
+  './src/nvim/message.h'
 )
 
 local function vimconv_alloc()
@@ -101,20 +102,21 @@ local function ga_alloc(itemsize, growsize)
 end
 
 local function check_emsg(f, msg)
-  local saved_last_msg_hist = lib.last_msg_hist
+  local saved_last_msg_hist = lib.msg_hist_get(-1)
   if saved_last_msg_hist == nil then
     saved_last_msg_hist = nil
   end
   local ret = { f() }
-  local last_msg = lib.last_msg_hist ~= nil and ffi.string(lib.last_msg_hist.msg) or nil
+  local last_msg_hist = lib.msg_hist_get(-1)
+  local last_msg = last_msg_hist ~= nil and ffi.string(last_msg_hist.msg) or nil
   if msg ~= nil then
     eq(msg, last_msg)
-    neq(saved_last_msg_hist, lib.last_msg_hist)
+    neq(saved_last_msg_hist, last_msg_hist)
   else
-    if saved_last_msg_hist ~= lib.last_msg_hist then
+    if saved_last_msg_hist ~= last_msg_hist then
       eq(nil, last_msg)
     else
-      eq(saved_last_msg_hist, lib.last_msg_hist)
+      eq(saved_last_msg_hist, last_msg_hist)
     end
   end
   return unpack(ret)
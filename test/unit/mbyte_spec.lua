@@ -273,4 +273,31 @@ describe('mbyte', function()
       eq(expected_offsets, { b = b_offsets, e = e_offsets })
     end)
   end)
+
+  describe('ascii_printable_len', function()
+    local function len(str, n)
+      return tonumber(lib.ascii_printable_len(str, n or #str))
+    end
+
+    itp('counts printable ASCII', function()
+      eq(0, len(''))
+      eq(5, len('hello'))
+      eq(40, len(('x'):rep(40)))
+      eq(3, len('abc\tdef'))
+      eq(17, len(('y'):rep(17) .. '\1'))
+      eq(33, len(('z'):rep(33) .. '\127' .. ('z'):rep(20)))
+    end)
+
+    itp('stops at the length', function()
+      eq(20, len(('x'):rep(40), 20))
+      eq(3, len('abcdef', 3))
+    end)
+
+    itp('leaves the byte before a multi-byte character', function()
+      eq(0, len('\xc3\xa4bc'))
+      eq(2, len('abc\xcc\x81'))
+      eq(19, len(('a'):rep(20) .. '\xe2\x82\xac'))
+      eq(20, len(('a'):rep(20) .. '\xe2\x82\xac', 20))
+    end)
+  end)
 end)